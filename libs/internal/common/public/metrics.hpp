@@ -0,0 +1,365 @@
+#ifndef COMMON__METRICS_HPP
+#define COMMON__METRICS_HPP
+
+#include <algorithm>
+#include <array>
+#include <atomic>
+#include <chrono>
+#include <cmath>
+#include <cstdint>
+#include <limits>
+#include <map>
+#include <memory>
+#include <mutex>
+#include <ostream>
+#include <stdexcept>
+#include <string>
+#include <vector>
+
+
+namespace Metrics
+{
+	// Summary describes observed values: their count, sum, bounds and counts per power of 2
+	// \note: bucket 0 takes values below 2^minExponent (and non positive ones),
+	//        bucket i > 0 takes values in [2^(minExponent + i - 1), 2^(minExponent + i))
+	struct Summary
+	{
+		static constexpr int minExponent = -32;
+		static constexpr int bucketsCount = 64;
+
+		std::uint64_t count = 0;
+		double sum = 0;
+		double min = +std::numeric_limits<double>::infinity();
+		double max = -std::numeric_limits<double>::infinity();
+		std::array<std::uint64_t, bucketsCount> buckets{};
+
+		static int GetBucket(double value)
+		{
+			if (!(value > 0))
+			{
+				return 0;
+			}
+			return std::clamp(std::ilogb(value) - minExponent + 1, 0, bucketsCount - 1);
+		}
+
+		// returns an exclusive upper bound of the bucket's values
+		static double GetUpperBound(int bucket)
+		{
+			return bucket + 1 < bucketsCount
+				? std::ldexp(1., minExponent + bucket)
+				: std::numeric_limits<double>::infinity()
+				;
+		}
+
+		// \note: NANs are ignored
+		void Observe(double value)
+		{
+			if (std::isnan(value))
+			{
+				return;
+			}
+			++count;
+			sum += value;
+			min = std::min(min, value);
+			max = std::max(max, value);
+			++buckets[GetBucket(value)];
+		}
+
+		void Merge(const Summary& other)
+		{
+			count += other.count;
+			sum += other.sum;
+			min = std::min(min, other.min);
+			max = std::max(max, other.max);
+			for (size_t i = 0; i < buckets.size(); ++i)
+			{
+				buckets[i] += other.buckets[i];
+			}
+		}
+	};
+
+	enum class EKind
+	{
+		  eCounter
+		, eHistogram
+		, eTimer // a histogram of durations in seconds
+	};
+
+	// Report is a merged snapshot of all the registered metrics
+	struct Report
+	{
+		std::map<std::string, std::uint64_t> counters;
+		std::map<std::string, Summary> histograms;
+		std::map<std::string, Summary> timers;
+
+		// writes the report as a JSON object of 'counters', 'histograms' and 'timers'
+		// \note: only non empty buckets are written as [upper bound, count] pairs; infinite bounds are nulls
+		void WriteJSON(std::ostream& os) const
+		{
+			auto number = [&os](double value) -> std::ostream&
+			{
+				return std::isfinite(value) ? os << value : os << "null";
+			};
+			auto summaries = [&](const std::map<std::string, Summary>& list)
+			{
+				os << "{";
+				auto sep = "";
+				for (auto& [name, summary] : list)
+				{
+					os << sep << "\n\t\t\"" << name << "\": { \"count\": " << summary.count << ", \"sum\": ";
+					number(summary.sum) << ", \"min\": ";
+					number(summary.count ? summary.min : NAN) << ", \"max\": ";
+					number(summary.count ? summary.max : NAN) << ", \"mean\": ";
+					number(summary.count ? summary.sum / summary.count : NAN) << ", \"buckets\": [";
+					auto bsep = "";
+					for (int i = 0; i < Summary::bucketsCount; ++i)
+					{
+						if (summary.buckets[i])
+						{
+							os << bsep << "[";
+							number(Summary::GetUpperBound(i)) << ", " << summary.buckets[i] << "]";
+							bsep = ", ";
+						}
+					}
+					os << "] }";
+					sep = ",";
+				}
+				os << (list.size() ? "\n\t}" : "}");
+			};
+
+			auto precision = os.precision(10);
+			os << "{\n\t\"counters\": {";
+			auto sep = "";
+			for (auto& [name, value] : counters)
+			{
+				os << sep << "\n\t\t\"" << name << "\": " << value;
+				sep = ",";
+			}
+			os << (counters.size() ? "\n\t}" : "}");
+			os << ",\n\t\"histograms\": "; summaries(histograms);
+			os << ",\n\t\"timers\": "; summaries(timers);
+			os << "\n}\n";
+			os.precision(precision);
+		}
+	};
+
+	// Registry keeps the metrics' names and their per thread shards
+	// \note: a thread records to its own shard without locks; a shard of a finished thread is reused by a new one,
+	//        so the count of shards doesn't exceed the count of threads run at the same time
+	// \note: Collect and Reset must not run while metrics are recorded (e.g. between computation stages)
+	class Registry final
+	{
+	public:
+		static constexpr size_t maxCounters = 128;
+		static constexpr size_t maxSummaries = 32;
+
+		struct Shard
+		{
+			std::array<std::atomic<std::uint64_t>, maxCounters> counters{};
+			std::array<Summary, maxSummaries> summaries{};
+		};
+
+	public:
+		// \note: the registry is never destroyed, so metrics can be recorded by static objects
+		static Registry& Get()
+		{
+			static auto registry = new Registry();
+			return *registry;
+		}
+
+		// returns an index of the metric in its shards' array (the same for the same name)
+		size_t Register(const std::string& name, EKind kind)
+		{
+			auto lock = std::lock_guard(mutex);
+			if (auto pos = names.find(name); pos != names.end())
+			{
+				if (pos->second.kind != kind)
+				{
+					throw std::runtime_error("metric '" + name + "' is registered with another kind");
+				}
+				return pos->second.index;
+			}
+
+			auto& count = kind == EKind::eCounter ? countersCount : summariesCount;
+			if (count == (kind == EKind::eCounter ? maxCounters : maxSummaries))
+			{
+				throw std::runtime_error("too many metrics to register '" + name + "'");
+			}
+			names[name] = { kind, count };
+			return count++;
+		}
+
+		// returns the calling thread's shard
+		Shard& GetShard()
+		{
+			thread_local auto owner = Owner();
+			if (!owner.shard)
+			{
+				owner.shard = Acquire();
+			}
+			return *owner.shard;
+		}
+
+		auto Collect() const -> Report
+		{
+			auto lock = std::lock_guard(mutex);
+			auto report = Report();
+			for (auto& [name, info] : names)
+			{
+				if (info.kind == EKind::eCounter)
+				{
+					auto& value = report.counters[name];
+					for (auto& shard : shards)
+					{
+						value += shard->counters[info.index].load(std::memory_order_relaxed);
+					}
+					continue;
+				}
+				auto& summary = (info.kind == EKind::eTimer ? report.timers : report.histograms)[name];
+				for (auto& shard : shards)
+				{
+					summary.Merge(shard->summaries[info.index]);
+				}
+			}
+			return report;
+		}
+
+		// zeroes all the metrics keeping them registered
+		void Reset()
+		{
+			auto lock = std::lock_guard(mutex);
+			for (auto& shard : shards)
+			{
+				for (auto& counter : shard->counters)
+				{
+					counter.store(0, std::memory_order_relaxed);
+				}
+				shard->summaries.fill(Summary());
+			}
+		}
+
+	private:
+		// returns the shard to the registry when its thread ends
+		struct Owner
+		{
+			Shard* shard = nullptr;
+
+			~Owner()
+			{
+				if (shard)
+				{
+					Registry::Get().Release(shard);
+				}
+			}
+		};
+
+		struct Info
+		{
+			EKind  kind;
+			size_t index;
+		};
+
+		Registry() = default;
+
+		Shard* Acquire()
+		{
+			auto lock = std::lock_guard(mutex);
+			if (free.size())
+			{
+				auto shard = free.back();
+				free.pop_back();
+				return shard;
+			}
+			return shards.emplace_back(std::make_unique<Shard>()).get();
+		}
+
+		void Release(Shard* shard)
+		{
+			auto lock = std::lock_guard(mutex);
+			free.push_back(shard);
+		}
+
+	private:
+		mutable std::mutex mutex;
+		std::map<std::string, Info> names;
+		std::vector<std::unique_ptr<Shard>> shards;
+		std::vector<Shard*> free;
+		size_t countersCount = 0;
+		size_t summariesCount = 0;
+	};
+
+	// handles of metrics are meant to be static objects created once per name
+	// \note: a handle with a name of another kind's metric throws
+
+	class Counter
+	{
+	public:
+		explicit Counter(const std::string& name)
+			: index(Registry::Get().Register(name, EKind::eCounter))
+		{}
+
+		void Add(std::uint64_t value = 1) const
+		{
+			// \note: only the owning thread writes the shard
+			auto& counter = Registry::Get().GetShard().counters[index];
+			counter.store(counter.load(std::memory_order_relaxed) + value, std::memory_order_relaxed);
+		}
+
+	private:
+		size_t index;
+	};
+
+	class Histogram
+	{
+	public:
+		explicit Histogram(const std::string& name, EKind kind = EKind::eHistogram)
+			: index(Registry::Get().Register(name, kind))
+		{}
+
+		void Observe(double value) const
+		{
+			Registry::Get().GetShard().summaries[index].Observe(value);
+		}
+
+	private:
+		size_t index;
+	};
+
+	class Timer : public Histogram
+	{
+	public:
+		using Clock = std::chrono::steady_clock;
+
+		// observes a duration of its scope
+		class Scope
+		{
+		public:
+			Scope(const Timer& timer)
+				: timer(timer)
+				, start(Clock::now())
+			{}
+
+			~Scope()
+			{
+				timer.Observe(std::chrono::duration<double>(Clock::now() - start).count());
+			}
+
+		private:
+			const Timer& timer;
+			Clock::time_point start;
+		};
+
+	public:
+		explicit Timer(const std::string& name)
+			: Histogram(name, EKind::eTimer)
+		{}
+
+		Scope Measure() const
+		{
+			return Scope(*this);
+		}
+	};
+}
+
+
+#endif //!COMMON__METRICS_HPP
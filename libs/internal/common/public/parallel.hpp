@@ -0,0 +1,103 @@
+#ifndef COMMON__PARALLEL_HPP
+#define COMMON__PARALLEL_HPP
+
+#include <algorithm>
+#include <exception>
+#include <atomic>
+#include <thread>
+#include <mutex>
+#include <vector>
+
+
+namespace Parallel
+{
+	// returns a number of workers to be used instead of the requested one
+	// \note: 0 means 'one worker per hardware thread'
+	inline size_t GetWorkersCount(size_t requested)
+	{
+		if (requested > 0)
+		{
+			return requested;
+		}
+		return std::max<size_t>(1, std::thread::hardware_concurrency());
+	}
+
+	namespace Internal
+	{
+		inline bool& InsideWorker()
+		{
+			thread_local bool bInside = false;
+			return bInside;
+		}
+	}
+
+	// returns true if the calling thread executes a body of some For() call
+	inline bool IsWorker()
+	{
+		return Internal::InsideWorker();
+	}
+
+	// calls fn(i) for each i in [0, count) using up to 'workers' threads
+	// \note: the calling thread is one of the workers
+	// \note: items are claimed one by one, so a slow item doesn't stall the others
+	// \note: nested calls are executed sequentially by the calling worker
+	// \note: the first thrown exception is rethrown when all the workers are joined
+	template<typename Fn>
+	void For(size_t count, size_t workers, Fn&& fn)
+	{
+		workers = std::min(GetWorkersCount(workers), count);
+		if (workers <= 1 || IsWorker())
+		{
+			for (size_t i = 0; i < count; ++i)
+			{
+				fn(i);
+			}
+			return;
+		}
+
+		auto next  = std::atomic<size_t>(0);
+		auto mutex = std::mutex();
+		auto error = std::exception_ptr();
+		auto work  = [&]()
+		{
+			Internal::InsideWorker() = true;
+			for (auto i = next++; i < count; i = next++)
+			{
+				try
+				{
+					fn(i);
+				}
+				catch (...)
+				{
+					auto lock = std::lock_guard(mutex);
+					if (!error)
+					{
+						error = std::current_exception();
+					}
+					next = count;
+				}
+			}
+			Internal::InsideWorker() = false;
+		};
+
+		auto threads = std::vector<std::thread>();
+		threads.reserve(workers - 1);
+		for (size_t i = 1; i < workers; ++i)
+		{
+			threads.emplace_back(work);
+		}
+		work();
+
+		for (auto& thread : threads)
+		{
+			thread.join();
+		}
+		if (error)
+		{
+			std::rethrow_exception(error);
+		}
+	}
+}
+
+
+#endif //!COMMON__PARALLEL_HPP
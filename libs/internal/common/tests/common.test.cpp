@@ -0,0 +1,34 @@
+#include "gtest/gtest.h"
+#include "common.hpp"
+#include <utility>
+
+
+namespace
+{
+	class Holder
+	{
+	public:
+		int& Get(int i)
+		{
+			++calls;
+			return values[i];
+		}
+
+		const int& Get(int i) const
+		{
+			CONST_FUNCTION_ENTERY(Get(i));
+		}
+
+		int values[2] = { 1, 2 };
+		int calls = 0;
+	};
+}
+
+
+TEST(tests, common_constFunctionEntery)
+{
+	auto holder = Holder();
+	ASSERT_EQ(std::as_const(holder).Get(1), 2);
+	ASSERT_EQ(&std::as_const(holder).Get(0), &holder.values[0]);
+	ASSERT_EQ(holder.calls, 2);
+}
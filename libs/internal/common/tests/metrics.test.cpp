@@ -0,0 +1,71 @@
+#include "gtest/gtest.h"
+#include "metrics.hpp"
+#include "parallel.hpp"
+#include <sstream>
+
+
+TEST(tests, metrics_mergedShards)
+{
+	static const auto counter = Metrics::Counter("tests.merged.counter");
+	static const auto histogram = Metrics::Histogram("tests.merged.histogram");
+
+	// each call runs new threads, so the shards of the finished ones are reused
+	for (auto run = 0; run < 10; ++run)
+	{
+		Parallel::For(1000, 4, [](size_t i)
+		{
+			counter.Add();
+			histogram.Observe(double(i));
+		});
+	}
+
+	auto report = Metrics::Registry::Get().Collect();
+	EXPECT_EQ(report.counters["tests.merged.counter"], 10000);
+
+	auto& summary = report.histograms["tests.merged.histogram"];
+	EXPECT_EQ(summary.count, 10000);
+	EXPECT_EQ(summary.min, 0);
+	EXPECT_EQ(summary.max, 999);
+	EXPECT_EQ(summary.sum, 10 * 999 * 1000 / 2);
+	EXPECT_EQ(summary.buckets[Metrics::Summary::GetBucket(0)], 10);
+	EXPECT_EQ(summary.buckets[Metrics::Summary::GetBucket(1)], 10);
+	EXPECT_EQ(summary.buckets[Metrics::Summary::GetBucket(512)], 10 * (1000 - 512));
+}
+
+TEST(tests, metrics_buckets)
+{
+	using Metrics::Summary;
+	for (auto value : { 1e-12, 0.3, 1., 1.5, 2., 1000., 1e+12 })
+	{
+		auto bucket = Summary::GetBucket(value);
+		EXPECT_LT(value, Summary::GetUpperBound(bucket));
+		if (bucket > 0)
+		{
+			EXPECT_GE(value, Summary::GetUpperBound(bucket - 1));
+		}
+	}
+	EXPECT_EQ(Summary::GetBucket(-1), 0);
+	EXPECT_EQ(Summary::GetBucket(1e+300), Summary::bucketsCount - 1);
+}
+
+TEST(tests, metrics_json)
+{
+	static const auto timer = Metrics::Timer("tests.json.timer");
+	static const auto counter = Metrics::Counter("tests.json.counter");
+	{
+		auto scope = timer.Measure();
+		counter.Add(3);
+	}
+	// the same name gets the same metric, but not of another kind
+	Metrics::Counter("tests.json.counter").Add(1);
+	EXPECT_ANY_THROW(Metrics::Histogram("tests.json.counter"));
+
+	auto os = std::ostringstream();
+	Metrics::Registry::Get().Collect().WriteJSON(os);
+	auto json = os.str();
+	EXPECT_NE(json.find("\"tests.json.counter\": 4"), std::string::npos);
+	EXPECT_NE(json.find("\"tests.json.timer\": { \"count\": 1,"), std::string::npos);
+
+	Metrics::Registry::Get().Reset();
+	EXPECT_EQ(Metrics::Registry::Get().Collect().counters["tests.json.counter"], 0);
+}
@@ -0,0 +1,61 @@
+#include "gtest/gtest.h"
+#include "parallel.hpp"
+
+
+TEST(tests, parallel_allItemsOnce)
+{
+	auto hits = std::vector<std::atomic<int>>(1000);
+	Parallel::For(hits.size(), 4, [&hits](size_t i)
+	{
+		++hits[i];
+	});
+	for (auto& hit : hits)
+	{
+		ASSERT_EQ(hit, 1);
+	}
+}
+
+TEST(tests, parallel_singleWorker)
+{
+	auto order = std::vector<size_t>();
+	Parallel::For(10, 1, [&order](size_t i)
+	{
+		order.push_back(i);
+	});
+	ASSERT_EQ(order.size(), 10);
+	for (size_t i = 0; i < order.size(); ++i)
+	{
+		ASSERT_EQ(order[i], i);
+	}
+}
+
+TEST(tests, parallel_nested)
+{
+	auto hits = std::atomic<int>(0);
+	Parallel::For(8, 4, [&hits](size_t)
+	{
+		ASSERT_TRUE(Parallel::IsWorker());
+		Parallel::For(8, 4, [&hits](size_t)
+		{
+			++hits;
+		});
+	});
+	ASSERT_EQ(hits, 64);
+	ASSERT_FALSE(Parallel::IsWorker());
+}
+
+TEST(tests, parallel_exception)
+{
+	auto call = []()
+	{
+		Parallel::For(100, 4, [](size_t i)
+		{
+			if (i == 42)
+			{
+				throw std::runtime_error("item failed");
+			}
+		});
+	};
+	ASSERT_THROW(call(), std::runtime_error);
+	ASSERT_FALSE(Parallel::IsWorker());
+}
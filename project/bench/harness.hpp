@@ -0,0 +1,119 @@
+#ifndef BENCH__HARNESS_HPP
+#define BENCH__HARNESS_HPP
+
+#include <chrono>
+#include <functional>
+#include <map>
+#include <string>
+#include <vector>
+
+
+
+namespace Bench
+{
+	// runs the measured code 'iterations' times
+	using Loop  = std::function<void(size_t iterations)>;
+
+	// prepares data of a benchmark (isn't measured) and returns its loop
+	using Setup = std::function<Loop()>;
+
+	struct Benchmark
+	{
+		std::string name;
+		Setup setup;
+	};
+
+	struct Result
+	{
+		size_t iterations = 0;
+		double seconds = 0;
+		std::map<std::string, double> counters; // totals of the measured run (see Count)
+
+		double GetNanoseconds() const
+		{
+			return iterations ? seconds * 1e+9 / iterations : 0;
+		}
+	};
+
+	inline std::vector<Benchmark>& GetBenchmarks()
+	{
+		static auto benchmarks = std::vector<Benchmark>();
+		return benchmarks;
+	}
+
+	inline std::map<std::string, double>& GetCounters()
+	{
+		static auto counters = std::map<std::string, double>();
+		return counters;
+	}
+
+	// adds a value to a counter of the running benchmark; counters are reported per iteration
+	// \note: must be called from the loop's thread
+	inline void Count(const std::string& name, double value)
+	{
+		GetCounters()[name] += value;
+	}
+
+	struct Registrar
+	{
+		Registrar(const std::string& name, Setup setup)
+		{
+			GetBenchmarks().push_back({ name, std::move(setup) });
+		}
+	};
+
+	// keeps a value computed by a loop, so the computation can't be dropped by the compiler
+	// \note: GCC and Clang see the value read by an empty asm statement; other compilers read its bytes as volatile
+	template<typename T>
+	void Keep(const T& value)
+	{
+#if defined(__GNUC__)
+		asm volatile("" : : "r,m"(value) : "memory");
+#else
+		static thread_local volatile char sink = 0;
+		auto bytes = reinterpret_cast<const volatile char*>(&value);
+		for (size_t i = 0; i < sizeof(T); ++i)
+		{
+			sink = bytes[i];
+		}
+#endif
+	}
+
+	// runs the loop with growing iterations until a run takes minTime
+	// \note: the loop is run once before the measurements to warm caches and lazy tables up
+	inline Result Run(const Benchmark& benchmark, double minTime)
+	{
+		using Clock = std::chrono::steady_clock;
+		auto loop = benchmark.setup();
+		loop(1);
+
+		auto result = Result();
+		for (size_t iterations = 1; ; )
+		{
+			GetCounters().clear();
+			auto start = Clock::now();
+			loop(iterations);
+			auto seconds = std::chrono::duration<double>(Clock::now() - start).count();
+
+			result = { iterations, seconds, GetCounters() };
+			if (seconds >= minTime)
+			{
+				return result;
+			}
+			auto factor = seconds > 0 ? minTime / seconds * 1.2 : 100.;
+			iterations = size_t(iterations * std::min(std::max(factor, 2.), 100.));
+		}
+	}
+}
+
+
+// registers a benchmark "group.name"; the body is its setup returning a Bench::Loop
+#define BENCHMARK(group, name)														\
+	static Bench::Loop Bench_##group##_##name();										\
+	static const auto Bench_registrar_##group##_##name =							\
+		Bench::Registrar(#group "." #name, &Bench_##group##_##name);				\
+	static Bench::Loop Bench_##group##_##name()										\
+/**/
+
+
+#endif //!BENCH__HARNESS_HPP
@@ -0,0 +1,71 @@
+#include "harness.hpp"
+#include "trajectory/keplerOrbit.hpp"
+#include "math/math.hpp"
+
+
+namespace af = Pathfinder::Kepler::Elliptic;
+
+namespace
+{
+	// Earth -> Mars locations of the Kepler tests
+	const FReal r0 = 1.496E+11;
+	const FReal r1 = 2.279E+11;
+	const FReal Q0 = DEG2RAD(10);
+	const FReal Q1 = DEG2RAD(260);
+	const FReal GM = 1.327E+20;
+
+	auto MakeAngles(size_t count)
+	{
+		auto f0s = std::vector<FReal>(count);
+		for (size_t i = 0; i < count; ++i)
+		{
+			f0s[i] = af::NZ(2*Math::Pi * i / count);
+		}
+		return f0s;
+	}
+}
+
+
+BENCHMARK(kepler, epwqq)
+{
+	return [f0s = MakeAngles(720)](size_t iterations)
+	{
+		for (size_t i = 0; i < iterations; ++i)
+		{
+			auto result = af::epwqq(r0, r1, Q0, Q1, f0s[i % f0s.size()]);
+			Bench::Keep(result);
+		}
+	};
+}
+
+BENCHMARK(kepler, dt)
+{
+	auto [orbit, bOK] = af::epwqq(r0, r1, Q0, Q1, DEG2RAD(120));
+	return [orbit = orbit](size_t iterations)
+	{
+		for (size_t i = 0; i < iterations; ++i)
+		{
+			auto M0 = af::M(af::E(orbit.q0, r0, orbit.e), orbit.e);
+			auto M1 = af::M(af::E(orbit.q1, r1, orbit.e), orbit.e);
+			auto dt = af::dt(M0, M1, af::a(orbit.e, orbit.p), GM, af::bf(Q0, DEG2RAD(120)));
+			Bench::Keep(dt);
+		}
+	};
+}
+
+// an iteration solves 720 toss angles
+BENCHMARK(kepler, batch720)
+{
+	auto batch = std::make_shared<af::Batch>();
+	auto f0s = MakeAngles(720);
+	batch->Resize(f0s.size());
+	std::copy(f0s.begin(), f0s.end(), batch->f0.begin());
+	return [batch](size_t iterations)
+	{
+		for (size_t i = 0; i < iterations; ++i)
+		{
+			af::Solve(*batch, r0, r1, Q0, Q1, GM);
+			Bench::Keep(batch->dt[i % batch->GetCount()]);
+		}
+	};
+}
@@ -0,0 +1,124 @@
+#include "harness.hpp"
+#include "circularMission.hpp"
+#include "blocks/link.hpp"
+#include "blocks/rootWindow.hpp"
+
+
+namespace
+{
+	using namespace Pathfinder;
+
+	auto MakeAngles()
+	{
+		auto f0s = std::vector<FReal>();
+		for (auto i = 0; i < 60; ++i)
+		{
+			f0s.push_back(DEG2RAD(6 * i));
+		}
+		return f0s;
+	}
+
+	// \note: the config keeps a pointer to B's script, so the script is kept by the loop
+	auto MakeScriptedConfig(const std::shared_ptr<Circular::Script>& B)
+	{
+		return Circular::MakeScriptedConfig(*Circular::MakeEarth(), *B);
+	}
+
+	auto MakeStaticConfig()
+	{
+		auto A = Circular::MakeEarth();
+		auto conf = Link::StaticLinkConfig();
+		conf.t0 = 0;
+		conf.SetA(*A);
+		conf.RB = Circular::MakeMars()->GetLocation(0);
+		conf.GM = Circular::MakeSun()->GetGM(0);
+		return conf;
+	}
+
+	// \note: the scan of Link_tests.rootPolishers; the mismatch tolerance is tight, so roots are polished a lot
+	Bench::Loop MakePolish(ERootPolisher polisher)
+	{
+		auto B = Circular::MakeMars(.5 + 0.776);
+		auto conf = Circular::MakeScriptedConfig(*Circular::MakeEarth(.5), *B, 3600.);
+		conf.polisher = polisher;
+
+		auto f0s = std::vector<FReal>();
+		for (auto i = 0; i < 90; ++i)
+		{
+			f0s.push_back(DEG2RAD(4 * i));
+		}
+		return [conf, B, f0s](size_t iterations) mutable
+		{
+			auto links = std::vector<Link::Link>();
+			for (size_t i = 0; i < iterations; ++i)
+			{
+				auto counters = Link::PolishCounters();
+				conf.counters = &counters;
+				links.clear();
+				Link::FindLinks(links, conf, f0s);
+				Bench::Keep(links.size());
+				Bench::Count("links", FReal(links.size()));
+				Bench::Count("evaluations", FReal(counters.evaluations));
+				Bench::Count("found", FReal(counters.found));
+			}
+		};
+	}
+
+	template<typename Config>
+	Bench::Loop MakeFindLinks(Config conf, Link::EKernel kernel, std::shared_ptr<void> keep = nullptr)
+	{
+		return [conf, kernel, keep, f0s = MakeAngles()](size_t iterations)
+		{
+			auto links = std::vector<Link::Link>();
+			for (size_t i = 0; i < iterations; ++i)
+			{
+				links.clear();
+				Link::FindLinks(links, conf, f0s, kernel);
+				Bench::Keep(links.size());
+			}
+		};
+	}
+}
+
+
+// an iteration solves the links of 60 toss angles
+BENCHMARK(link, static60_scalar) { return MakeFindLinks(MakeStaticConfig(), Link::EKernel::eScalar); }
+BENCHMARK(link, static60_batch ) { return MakeFindLinks(MakeStaticConfig(), Link::EKernel::eBatch ); }
+
+BENCHMARK(link, scripted60_scalar)
+{
+	auto B = Circular::MakeMars();
+	return MakeFindLinks(MakeScriptedConfig(B), Link::EKernel::eScalar, B);
+}
+
+BENCHMARK(link, scripted60_batch)
+{
+	auto B = Circular::MakeMars();
+	return MakeFindLinks(MakeScriptedConfig(B), Link::EKernel::eBatch, B);
+}
+
+// an iteration scans 90 toss angles; counters report transfers the polisher solved and roots it found
+BENCHMARK(link, polish_bisection) { return MakePolish(ERootPolisher::eBisection); }
+BENCHMARK(link, polish_illinois ) { return MakePolish(ERootPolisher::eIllinois ); }
+BENCHMARK(link, polish_brent    ) { return MakePolish(ERootPolisher::eBrent    ); }
+
+// an iteration pushes one point of a mismatch function with roots and extrema
+BENCHMARK(link, rootWindow)
+{
+	auto deltas = std::vector<FReal>();
+	for (auto i = 0; i < 1024; ++i)
+	{
+		deltas.push_back(Math::Sin(i * 0.05) + 0.3 * Math::Sin(i * 0.4));
+	}
+	return [deltas](size_t iterations)
+	{
+		auto window = Link::Utiles::RootWindowHelper(1e-6);
+		auto found = size_t(0);
+		for (size_t i = 0; i < iterations; ++i)
+		{
+			window.Push(FReal(i), deltas[i % deltas.size()]);
+			found += window.CheckRoot();
+		}
+		Bench::Keep(found);
+	};
+}
@@ -0,0 +1,56 @@
+#include "harness.hpp"
+
+#include <gflags/gflags.h>
+#include <iomanip>
+#include <iostream>
+
+
+DEFINE_string(filter , ""  , "runs only benchmarks whose names contain the string");
+DEFINE_double(minTime, 0.5 , "[s] - min time of a measured run of a benchmark");
+DEFINE_bool  (list   , false, "lists the benchmarks without running them");
+
+
+
+int main(int argc, char** argv)
+{
+	gflags::SetUsageMessage("\n"
+		"[ -filter=\"kepler.\" ] \n"
+		"[ -minTime=0.5      ] \n"
+		"[ -list             ] \n"
+	);
+
+	try
+	{
+		gflags::ParseCommandLineFlags(&argc, &argv, true);
+
+		for (auto& benchmark : Bench::GetBenchmarks())
+		{
+			if (benchmark.name.find(FLAGS_filter) == std::string::npos)
+			{
+				continue;
+			}
+			if (FLAGS_list)
+			{
+				std::cout << benchmark.name << std::endl;
+				continue;
+			}
+
+			auto result = Bench::Run(benchmark, FLAGS_minTime);
+			std::cout << std::left << std::setw(40) << benchmark.name << std::right
+				<< std::setw(14) << std::fixed << std::setprecision(1) << result.GetNanoseconds() << " ns"
+				<< std::setw(14) << result.iterations << " iterations";
+			for (auto& [name, total] : result.counters)
+			{
+				std::cout << "  " << name << "=" << total / result.iterations;
+			}
+			std::cout << std::endl;
+		}
+	}
+	catch (const std::exception& e)
+	{
+		std::cerr << "Unexpected exception:" << std::endl;
+		std::cerr << e.what() << std::endl;
+		return 1;
+	}
+	return 0;
+}
@@ -0,0 +1,63 @@
+#include "harness.hpp"
+#include <memory>
+#include <stdexcept>
+#include "solvers/pathTree.hpp"
+
+
+namespace
+{
+	using Tree = Pathfinder::PathTree<int>;
+
+	// fills a tree with levels of 'fanOut' children of each node of the previous level
+	auto MakeTree(std::vector<Tree::pathID>& leaves, size_t levels, size_t fanOut)
+	{
+		auto tree = std::make_shared<Tree>();
+		tree->RegisterOnAdded([](int& parent, int& child)
+		{
+			child += parent;
+		});
+
+		leaves = { tree->AppendPath(0) };
+		for (size_t level = 1; level < levels; ++level)
+		{
+			auto children = std::vector<Tree::pathID>();
+			for (auto parent : leaves)
+			for (size_t i = 0; i < fanOut; ++i)
+			{
+				children.push_back(tree->AppendPath(int(i), parent));
+			}
+			leaves = std::move(children);
+		}
+		return tree;
+	}
+}
+
+
+// an iteration appends 4 levels of 8 children (4681 paths)
+BENCHMARK(pathTree, appendPath)
+{
+	return [](size_t iterations)
+	{
+		auto leaves = std::vector<Tree::pathID>();
+		for (size_t i = 0; i < iterations; ++i)
+		{
+			auto tree = MakeTree(leaves, 5, 8);
+			Bench::Keep(tree->GetSize());
+		}
+	};
+}
+
+// an iteration materialises one path of 5 nodes
+BENCHMARK(pathTree, getFullPathByID)
+{
+	auto leaves = std::vector<Tree::pathID>();
+	auto tree = MakeTree(leaves, 5, 8);
+	return [tree, leaves](size_t iterations)
+	{
+		for (size_t i = 0; i < iterations; ++i)
+		{
+			auto path = tree->GetFullPathByID(leaves[i % leaves.size()]);
+			Bench::Keep(path.size());
+		}
+	};
+}
@@ -0,0 +1,62 @@
+#include "harness.hpp"
+#include "circularMission.hpp"
+#include "planetScript.hpp"
+#include "trajectory/ephemerisTable.hpp"
+
+
+namespace
+{
+	using namespace Pathfinder;
+
+	constexpr auto day = 3600. * 24;
+	constexpr auto range = 365. * 2 * day;
+
+	// the times are spread over the range, so the discrete lookups don't hit one row
+	auto MakeTimes()
+	{
+		auto times = std::vector<FReal>();
+		for (auto i = 0; i < 4096; ++i)
+		{
+			times.push_back(std::fmod(i * 7919. * 3600, range));
+		}
+		return times;
+	}
+
+	template<typename Script>
+	Bench::Loop MakeGetMovement(std::shared_ptr<Script> script)
+	{
+		return [script, times = MakeTimes()](size_t iterations)
+		{
+			for (size_t i = 0; i < iterations; ++i)
+			{
+				auto movement = script->GetMovement(times[i % times.size()]);
+				Bench::Keep(movement);
+			}
+		};
+	}
+}
+
+
+// the continuous ephemerides are the circular orbit's formulas
+BENCHMARK(planetScript, getMovement_continuous)
+{
+	return MakeGetMovement(Circular::MakeEarth());
+}
+
+// the discrete ephemerides are a table sampled from the circular orbit
+// \note: SPICE backed scripts are continuous, or discrete with chunks filled from SPICE
+BENCHMARK(planetScript, getMovement_discrete)
+{
+	auto orbit = Circular::MakeEarth();
+	auto script = std::make_shared<PlanetScript::PlanetScript>(PlanetScript::EPlanet::eEarth, 0., orbit->GM, orbit->period);
+	script->MakeDiscret(day, day * 90);
+
+	auto table = std::make_unique<Ephemerides::EphemerisTable>(0, day, size_t(range / day) + 1);
+	for (size_t row = 0; row < table->GetCount(); ++row)
+	{
+		auto [R, V] = orbit->GetMovement(table->GetSampleTime(row));
+		table->SetRow(row, R, V);
+	}
+	script->AttachTable(std::move(table));
+	return MakeGetMovement(script);
+}
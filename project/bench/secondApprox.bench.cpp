@@ -0,0 +1,50 @@
+#include "harness.hpp"
+#include "circularMission.hpp"
+#include "solvers/FirstApprox.hpp"
+#include "solvers/SecondApprox.hpp"
+#include <algorithm>
+
+
+namespace
+{
+	using namespace Pathfinder;
+
+	// \note: the minimisations of pathfinder_tests.saxMinimisers on the best FAX flight
+	Bench::Loop MakeSecondApprox(ESAXMinimiser minimiser)
+	{
+		auto mission = std::make_shared<Mission>(Circular::MakeMission());
+		mission->saxConfig.minimiser = minimiser;
+		auto functionality = PathFinder::Functionality([](const PathFinder::FlightChain& flight)
+		{
+			return flight.Impulse;
+		});
+
+		auto flights = Solvers::FirstApprox(*mission, mission->t0);
+		auto best = std::min_element(flights.begin(), flights.end(), [&](auto& a, auto& b)
+		{
+			return functionality(a) < functionality(b);
+		});
+		if (best == flights.end())
+		{
+			throw std::runtime_error("the mission has no FAX flights to optimise");
+		}
+
+		return [mission, functionality, seed = *best](size_t iterations)
+		{
+			for (size_t i = 0; i < iterations; ++i)
+			{
+				auto evaluations = UInt64(0);
+				auto result = Solvers::SecondApprox(*mission, seed, functionality, &evaluations);
+				Bench::Keep(std::get<1>(result));
+				Bench::Count("evaluations", FReal(evaluations));
+				Bench::Count("value", std::get<1>(result));
+			}
+		};
+	}
+}
+
+
+// an iteration optimises the best FAX flight of the fixture's mission; counters report the minimiser's work and result
+BENCHMARK(secondApprox, circular_simplex  ) { return MakeSecondApprox(ESAXMinimiser::eSimplex  ); }
+BENCHMARK(secondApprox, circular_bfgs2    ) { return MakeSecondApprox(ESAXMinimiser::eBFGS2    ); }
+BENCHMARK(secondApprox, circular_conjugate) { return MakeSecondApprox(ESAXMinimiser::eConjugate); }
@@ -50,13 +50,38 @@ namespace PlanetConfig_::Utiles
 
 
 
-Pathfinder::Nodes::INode::ptr PlanetConfig::ProduceNode(const TimeConfig& deskConf) const
+Pathfinder::Nodes::INode::ptr PlanetConfig::ProduceNode(const TimeConfig& deskConf, const Pathfinder::PlanetScript::EphemerisCache* cache) const
 {
 	using namespace PlanetConfig_;
 	using namespace Pathfinder;
 	
-	auto script = Utiles::CreatePlanetScript(planet, deskConf.startDate);
-	script->MakeDiscret(deskConf.discretisation, deskConf.chunkSize);
+	auto script = PlanetScript::PlanetScript::ptr();
+	if (cache)
+	{
+		// \note: cached scripts are already discret and have their tables mapped
+		// \note: they don't fall back to SPICE, so the mission's range is checked before the run starts
+		script = cache->MakeScript(utiles::GetPlanetName(planet), deskConf.startDate);
+		if (script->GetDiscretisation() != std::make_tuple(deskConf.discretisation, deskConf.chunkSize))
+		{
+			throw std::runtime_error("the ephemerides cache was built with another discretisation or chunk size");
+		}
+
+		auto [tBegin, tEnd] = cache->GetRange(utiles::GetPlanetName(planet));
+		if (deskConf.t0 < tBegin || deskConf.t0 + deskConf.t1 + deskConf.preloadTail >= tEnd)
+		{
+			throw std::runtime_error("the ephemerides cache of '" + planet + "' doesn't cover the mission's times [t0, t0 + t1 + preloadTail]");
+		}
+	}
+	else
+	{
+		script = Utiles::CreatePlanetScript(planet, deskConf.startDate);
+		script->MakeDiscret(deskConf.discretisation, deskConf.chunkSize);
+	}
+	if (!cache && deskConf.preloadTail > 0)
+	{
+		// \note: mission's times are t0 + (sweep offset from [t0, t1]) + (flight time)
+		script->Preload(deskConf.t0, deskConf.t0 + deskConf.t1 + deskConf.preloadTail);
+	}
 
 
 	switch (Utiles::GetNodeType(nodeType)) {
@@ -4,6 +4,7 @@
 #include "configs/timeConfig.hpp"
 #include "pathfinder.hpp"
 #include "nodes.hpp"
+#include "ephemerisCache.hpp"
 
 
 
@@ -48,7 +49,7 @@ public:
 	FReal kink_k = 1;
 
 public:
-	Pathfinder::Nodes::INode::ptr ProduceNode(const TimeConfig& deskConf) const;
+	Pathfinder::Nodes::INode::ptr ProduceNode(const TimeConfig& deskConf, const Pathfinder::PlanetScript::EphemerisCache* cache = nullptr) const;
 };
 
 
@@ -1,5 +1,7 @@
 #include "configs/problemConfig.hpp"
-#include "planetScript.hpp"
+#include "utiles/getPlanetName.hpp"
+#include <algorithm>
+#include <boost/algorithm/string.hpp>
 
 
 
@@ -13,6 +15,41 @@ namespace AXConf_::Utiles
 		}
 		throw std::runtime_error("field '" + name + "' must be set.");
 	}
+
+	Pathfinder::ELinkSolver GetLinkSolver(const std::string& solver_)
+	{
+		auto solver = boost::to_lower_copy(solver_);
+		if (solver == "scan"   ) return Pathfinder::ELinkSolver::eScan;
+		if (solver == "lambert") return Pathfinder::ELinkSolver::eLambert;
+		throw std::runtime_error("unexpected link solver: " + solver);
+	}
+
+	Pathfinder::ERootPolisher GetRootPolisher(const std::string& polisher_)
+	{
+		auto polisher = boost::to_lower_copy(polisher_);
+		if (polisher == "bisection") return Pathfinder::ERootPolisher::eBisection;
+		if (polisher == "illinois" ) return Pathfinder::ERootPolisher::eIllinois;
+		if (polisher == "brent"    ) return Pathfinder::ERootPolisher::eBrent;
+		throw std::runtime_error("unexpected root polisher: " + polisher);
+	}
+
+	Pathfinder::ESAXMinimiser GetSAXMinimiser(const std::string& minimiser_)
+	{
+		auto minimiser = boost::to_lower_copy(minimiser_);
+		if (minimiser == "simplex"  ) return Pathfinder::ESAXMinimiser::eSimplex;
+		if (minimiser == "bfgs2"    ) return Pathfinder::ESAXMinimiser::eBFGS2;
+		if (minimiser == "conjugate") return Pathfinder::ESAXMinimiser::eConjugate;
+		throw std::runtime_error("unexpected SAX minimiser: " + minimiser);
+	}
+
+	Pathfinder::ESAXGlobal GetSAXGlobal(const std::string& global_)
+	{
+		auto global = boost::to_lower_copy(global_);
+		if (global == "none"      ) return Pathfinder::ESAXGlobal::eNone;
+		if (global == "de"        ) return Pathfinder::ESAXGlobal::eDifferentialEvolution;
+		if (global == "multistart") return Pathfinder::ESAXGlobal::eMultiStart;
+		throw std::runtime_error("unexpected SAX global search: " + global);
+	}
 }
 
 #define AX_CONF_CHECK(field)						\
@@ -39,6 +76,7 @@ Pathfinder::MissionConfig AXConf::MakeConfig(const TimeConfig& tconf) const
 	conf.timeFrac = tconf.discretisation;
 	conf.timeStep = AX_CONF_CHECK(timeStep);
 	conf.timeTol  = AX_CONF_CHECK(timeTol );
+	conf.rootPolisher = AXConf_::Utiles::GetRootPolisher(rootPolisher);
 	return conf;
 }
 
@@ -49,6 +87,9 @@ Pathfinder::FAXConfig FAXConf::MakeConfig(const TimeConfig& tconf) const
 
 	auto conf = Pathfinder::FAXConfig();
 	conf.CopyValus(AXConf::MakeConfig(tconf));
+	conf.legCacheLimit = size_t(Math::Max(legCacheSize, FReal(0)) * 1024 * 1024);
+	conf.pruneTopK = size_t(Math::Max(pruneTopK, 0));
+	conf.linkSolver = AXConf_::Utiles::GetLinkSolver(linkSolver);
 	return conf;
 }
 
@@ -65,6 +106,15 @@ Pathfinder::SAXConfig SAXConf::MakeConfig(const TimeConfig& tconf) const
 	conf.initialBurnPointStep = AX_CONF_CHECK(initialBurnPointStep);
 	conf.initialTossAngleStep = AX_CONF_CHECK(initialTossAngleStep);
 	conf.initialTimeStep = AX_CONF_CHECK(initialTimeStep);
+	conf.minimiser = AXConf_::Utiles::GetSAXMinimiser(minimiser);
+	conf.gradientStep = AX_CONF_CHECK(gradientStep);
+	conf.global = AXConf_::Utiles::GetSAXGlobal(global);
+	conf.evaluationBudget = UInt64(Math::Max(evaluationBudget, 0));
+	conf.globalPopulation = globalPopulation;
+	conf.globalSpread = AX_CONF_CHECK(globalSpread);
+	conf.deWeight = AX_CONF_CHECK(deWeight);
+	conf.deCrossover = AX_CONF_CHECK(deCrossover);
+	conf.randomSeed = UInt64(Math::Max(randomSeed, 0));
 	conf.burnNodeFactory = [
 		  i = AX_CONF_CHECK(burnImpulseLimit)
 		, a = AX_CONF_CHECK(burnImpulse_a)
@@ -99,27 +149,63 @@ FunctionalityConfig::Functionality FunctionalityConfig::MakeFunctionality() cons
 	};
 }
 
+FunctionalityConfig::Functionality FunctionalityConfig::MakePartialBound() const
+{
+	using Pathfinder::PathFinder;
 
-Pathfinder::Mission ProblemConfig::MakeMission() const
+	const auto type = std::string("Mission.Functionality");
+
+	auto m = AX_CONF_CHECK(mismatch);
+	auto i = AX_CONF_CHECK(impulse);
+	auto t = AX_CONF_CHECK(time);
+	if (m < 0 || i < 0 || t < 0 || AX_CONF_CHECK(correction) < 0)
+	{
+		throw std::runtime_error(type + " weights must be non negative to prune flights");
+	}
+
+	// \note: mismatch, impulse and time only grow along a flight, and a correction is non negative
+	return [m, i, t](const PathFinder::FlightChain& partial) {
+		return m * partial.Mismatch
+			+  i * partial.Impulse
+			+  t * partial.totalTime;
+	};
+}
+
+
+Pathfinder::Mission ProblemConfig::MakeMission(const Pathfinder::PlanetScript::EphemerisCache* cache) const
 {
 	using Pathfinder::PlanetScript::PlanetScript;
 	using Pathfinder::PlanetScript::EPlanet;
 
-	const auto sun = PlanetScript(EPlanet::eSun, timeSettings.startDate);
-
 	auto mission = Pathfinder::Mission();
 	mission.faxConfig = faxConf.MakeConfig(timeSettings);
 	mission.saxConfig = saxConf.MakeConfig(timeSettings);
 	mission.t0 = timeSettings.t0;
-	mission.GM = sun.GetGM(0);
+	mission.GM = cache
+		? cache->GetGM(EPlanet::eSun)
+		: PlanetScript(EPlanet::eSun, timeSettings.startDate).GetGM(0);
 	for (auto planet : planets)
 	{
-		mission.nodes.push_back(planet.ProduceNode(timeSettings));
+		mission.nodes.push_back(planet.ProduceNode(timeSettings, cache));
 	}
 	return mission;
 }
 
-Pathfinder::PathFinder ProblemConfig::MakeFinder() const
+auto ProblemConfig::GetBodies() const -> std::vector<Pathfinder::PlanetScript::EPlanet>
+{
+	auto bodies = std::vector<Pathfinder::PlanetScript::EPlanet>{ Pathfinder::PlanetScript::EPlanet::eSun };
+	for (auto& planet : planets)
+	{
+		auto body = utiles::GetPlanetName(planet.planet);
+		if (std::find(bodies.begin(), bodies.end(), body) == bodies.end())
+		{
+			bodies.push_back(body);
+		}
+	}
+	return bodies;
+}
+
+Pathfinder::PathFinder ProblemConfig::MakeFinder(const Pathfinder::PlanetScript::EphemerisCache* cache) const
 {
 	const auto type = std::string("Mission");
 
@@ -131,7 +217,15 @@ Pathfinder::PathFinder ProblemConfig::MakeFinder() const
 		throw std::runtime_error(type + "keepFactor must be in range of (0, 1]");
 	}
 
-	auto finder = Pathfinder::PathFinder(MakeMission());
+	auto finder = Pathfinder::PathFinder(MakeMission(cache));
 	finder.SetFunctionality(functionality.MakeFunctionality());
+	if (faxConf.pruneTopK > 0)
+	{
+		finder.SetPartialBound(functionality.MakePartialBound());
+	}
+	if (onlineFilter)
+	{
+		finder.SetOnlineFilter({ size_t(Math::Max(keepTopK, 0)), keepFactor });
+	}
 	return finder;
 }
@@ -2,6 +2,7 @@
 #define MAIN__PROBLEMCONFIG_HPP
 
 #include "configs/planetConfig.hpp"
+#include "ephemerisCache.hpp"
 
 
 
@@ -12,6 +13,7 @@ struct AXConf : public reflect::FConfig
 		ARCH_FIELD(, , points_f0)
 		ARCH_FIELD(, , timeStep)
 		ARCH_FIELD(, , timeTol)
+		ARCH_FIELD(, , rootPolisher)
 		ARCH_END()
 public:
 	FReal periodFactor = NAN;
@@ -19,6 +21,9 @@ public:
 	FReal timeStep = NAN;
 	FReal timeTol = NAN;
 
+	// polisher of roots the scan brackets: "bisection" (reference), "illinois" or "brent"
+	std::string rootPolisher = "bisection";
+
 	Pathfinder::MissionConfig MakeConfig(const TimeConfig& tconf) const;
 
 protected:
@@ -28,6 +33,27 @@ protected:
 
 struct FAXConf : public AXConf
 {
+	ARCH_BEGIN(AXConf)
+		ARCH_FIELD(, , legCacheSize)
+		ARCH_FIELD(, , pruneTopK)
+		ARCH_FIELD(, , linkSolver)
+		ARCH_END()
+public:
+
+	// [MB] - memory cap of legs memoised across launch dates (0 - no memoisation)
+	// \note: memoised legs are solved once per discretisation step
+	FReal legCacheSize = 0;
+
+	// count of the best flights of all launch dates branch and bound keeps (0 - all the flights are kept)
+	// \note: the mission functionality's weights must be non negative to bound partial flights
+	Int32 pruneTopK = 0;
+
+	// solver of legs to planets: "scan" - scans arrival times for every toss angle, "lambert" - solves
+	// Lambert's problem for every arrival time of the scan grid (points_f0 is ignored)
+	std::string linkSolver = "scan";
+
+public:
+
 	Pathfinder::FAXConfig MakeConfig(const TimeConfig& tconf) const;
 };
 
@@ -44,6 +70,15 @@ struct SAXConf : public AXConf
 		ARCH_FIELD(, , burnImpulseLimit)
 		ARCH_FIELD(, , burnImpulse_a)
 		ARCH_FIELD(, , burnImpulse_k)
+		ARCH_FIELD(, , minimiser)
+		ARCH_FIELD(, , gradientStep)
+		ARCH_FIELD(, , global)
+		ARCH_FIELD(, , evaluationBudget)
+		ARCH_FIELD(, , globalPopulation)
+		ARCH_FIELD(, , globalSpread)
+		ARCH_FIELD(, , deWeight)
+		ARCH_FIELD(, , deCrossover)
+		ARCH_FIELD(, , randomSeed)
 		ARCH_END()
 public:
 
@@ -59,6 +94,19 @@ public:
 	FReal burnImpulse_a = 1;
 	FReal burnImpulse_k = 4;
 
+	// "simplex" (Nelder-Mead), "bfgs2" or "conjugate" (both with central difference gradients)
+	std::string minimiser = "simplex";
+	FReal gradientStep = 0.01; // [-] - central difference steps as fractions of the initial steps
+
+	// "none", "de" (differential evolution) or "multistart" (local minimisations from random points)
+	std::string global = "none";
+	Int32 evaluationBudget = 2000;
+	Int32 globalPopulation = 20;
+	FReal globalSpread = 10;  // [-] - in initial steps
+	FReal deWeight = 0.7;
+	FReal deCrossover = 0.9;
+	Int32 randomSeed = 0;
+
 public:
 
 	Pathfinder::SAXConfig MakeConfig(const TimeConfig& tconf) const;
@@ -84,6 +132,9 @@ public:
 	using Functionality = Pathfinder::PathFinder::Functionality;
 
 	Functionality MakeFunctionality() const;
+
+	// returns a lower bound of the functionality for partial flights (see PathFinder::SetPartialBound)
+	Functionality MakePartialBound() const;
 };
 
 
@@ -96,6 +147,10 @@ struct ProblemConfig : public reflect::FConfig
 		ARCH_FIELD(, , faxConf)
 		ARCH_FIELD(, , saxConf)
 		ARCH_FIELD(, , keepFactor)
+		ARCH_FIELD(, , keepTopK)
+		ARCH_FIELD(, , onlineFilter)
+		ARCH_FIELD(, , clusterTime)
+		ARCH_FIELD(, , clusterAngle)
 		ARCH_END()
 public:
 
@@ -113,13 +168,26 @@ public:
 
 	FReal keepFactor = NAN;
 
-private:
+	// count of the best FAX flights to keep (0 - no limit)
+	Int32 keepTopK = 0;
+
+	// filters FAX flights during the sweep instead of after it (see PathFinder::SetOnlineFilter)
+	bool onlineFilter = false;
 
-	Pathfinder::Mission MakeMission() const;
+	// merges near FAX flights before SAX if both radii are positive (see PathFinder::ClusterResults)
+	FReal clusterTime = 0;  // [s]
+	FReal clusterAngle = 0; // [rad]
 
 public:
 
-	Pathfinder::PathFinder MakeFinder() const;
+	Pathfinder::Mission MakeMission(const Pathfinder::PlanetScript::EphemerisCache* cache = nullptr) const;
+
+	// \note: the bodies are read from the cache if it's passed
+	// \note: the online filter is set if it's enabled
+	Pathfinder::PathFinder MakeFinder(const Pathfinder::PlanetScript::EphemerisCache* cache = nullptr) const;
+
+	// returns all the bodies the mission needs ephemerides of
+	auto GetBodies() const->std::vector<Pathfinder::PlanetScript::EPlanet>;
 };
 
 
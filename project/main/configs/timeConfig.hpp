@@ -15,6 +15,7 @@ struct TimeConfig : public reflect::FConfig
 		ARCH_FIELD(, , t0)
 		ARCH_FIELD(, , t1)
 		ARCH_FIELD(, , dt)
+		ARCH_FIELD(, , preloadTail)
 		ARCH_END()
 public:
 	std::string startDate;
@@ -25,6 +26,9 @@ public:
 	FReal t1 = NAN; 
 	FReal dt = NAN;
 
+	// [s] - time after t1 to keep in flat ephemerides tables (0 - no tables)
+	FReal preloadTail = 0;
+
 	void CheckIsValid() const;
 };
 
@@ -0,0 +1,37 @@
+#ifndef MAIN__BUILDEPHEMCACHE_HPP
+#define MAIN__BUILDEPHEMCACHE_HPP
+
+#include "configs/problemConfig.hpp"
+#include "ephemerisCache.hpp"
+
+
+
+int BuildEphemCache(const std::string& outFile, const std::string& problemPath)
+{
+	auto conf = ProblemConfig();
+	if (!conf.LoadConfig(problemPath))
+	{
+		throw std::runtime_error("Cannot parse configuration file.");
+	}
+	conf.timeSettings.CheckIsValid();
+
+	auto& time = conf.timeSettings;
+	if (!(time.preloadTail > 0))
+	{
+		throw std::runtime_error("Mission.TimeSettings.preloadTail must be positive to build an ephemerides cache.");
+	}
+
+	// \note: the same range the mission preloads its tables for
+	auto bodies = conf.GetBodies();
+	auto tBegin = time.t0;
+	auto tEnd   = time.t0 + time.t1 + time.preloadTail;
+	std::cout << " >> sampling " << bodies.size() << " bodies over [" << tBegin << ", " << tEnd << "]... ";
+	Pathfinder::PlanetScript::EphemerisCache::Build(outFile, time.startDate, bodies, time.discretisation, time.chunkSize, tBegin, tEnd);
+	std::cout << "done" << std::endl;
+	std::cout << " >> ephemerides cache is saved to file: " << outFile << std::endl;
+
+	return 0;
+}
+
+
+#endif //!MAIN__BUILDEPHEMCACHE_HPP
@@ -0,0 +1,187 @@
+#ifndef MAIN__EXPORTPORKCHOP_HPP
+#define MAIN__EXPORTPORKCHOP_HPP
+
+#include "configs/problemConfig.hpp"
+#include "porkchop.hpp"
+#include "utiles/getPlanetName.hpp"
+#include "parallel.hpp"
+#include <filesystem>
+#include <fstream>
+#include <iostream>
+
+
+
+// PorkchopWriter streams porkchop rows to a file
+// \note: *.csv files get 't0,tof,w0,w1' lines (empty velocities - no transfer)
+// \note: other files get a binary layout (native byte order):
+//        magic[8] "GAPORK", UInt32 version, UInt32 sizeof(FReal), UInt64 rows, UInt64 cols,
+//        FReal departures[rows], FReal flightTimes[cols], {FReal w0[cols], FReal w1[cols]}[rows] (NAN - no transfer)
+class PorkchopWriter
+{
+public:
+	static constexpr UInt32 version = 1;
+
+public:
+	PorkchopWriter(const std::string& path, const Pathfinder::Porkchop::Porkchop& grid)
+		: os(path, std::ios::binary | std::ios::trunc)
+		, bCSV(std::filesystem::path(path).extension() == ".csv")
+		, departures(grid.GetDepartures())
+		, flightTimes(grid.GetFlightTimes())
+	{
+		if (!os)
+		{
+			throw std::runtime_error("Passed path cannot be opend on write: '" + path + "'");
+		}
+		if (bCSV)
+		{
+			os.precision(12);
+			os << "t0,tof,w0,w1\n";
+			return;
+		}
+
+		const char magic[8] = { 'G', 'A', 'P', 'O', 'R', 'K', '\0', '\0' };
+		const UInt32 realSize = sizeof(FReal);
+		const UInt64 rows = departures.size();
+		const UInt64 cols = flightTimes.size();
+		Write(magic, sizeof(magic));
+		Write(&version, sizeof(version));
+		Write(&realSize, sizeof(realSize));
+		Write(&rows, sizeof(rows));
+		Write(&cols, sizeof(cols));
+		Write(departures.data(), sizeof(FReal) * departures.size());
+		Write(flightTimes.data(), sizeof(FReal) * flightTimes.size());
+	}
+
+	void WriteRow(size_t row, const std::vector<Pathfinder::Porkchop::Cell>& cells)
+	{
+		if (bCSV)
+		{
+			for (size_t col = 0; col < cells.size(); ++col)
+			{
+				os << departures[row] << ',' << flightTimes[col] << ',';
+				if (!isnan(cells[col].w0))
+				{
+					os << cells[col].w0 << ',' << cells[col].w1;
+				}
+				else os << ',';
+				os << '\n';
+			}
+		}
+		else
+		{
+			buffer.resize(cells.size());
+			for (size_t col = 0; col < cells.size(); ++col) buffer[col] = cells[col].w0;
+			Write(buffer.data(), sizeof(FReal) * buffer.size());
+			for (size_t col = 0; col < cells.size(); ++col) buffer[col] = cells[col].w1;
+			Write(buffer.data(), sizeof(FReal) * buffer.size());
+		}
+		if (!os)
+		{
+			throw std::runtime_error("Cannot write porkchop row: " + std::to_string(row));
+		}
+	}
+
+private:
+	void Write(const void* data, size_t size)
+	{
+		os.write(static_cast<const char*>(data), size);
+	}
+
+private:
+	std::ofstream os;
+	bool bCSV = false;
+	std::vector<FReal> departures;
+	std::vector<FReal> flightTimes;
+	std::vector<FReal> buffer;
+};
+
+
+
+int ExportPorkchop(
+	const std::string& outFile,
+	const std::string& problemPath,
+	Int32 nodeA,
+	Int32 nodeB,
+	FReal tofMin,
+	FReal tofMax,
+	FReal tofStep,
+	Int32 threads = 1,
+	const std::string& cachePath = ""
+) {
+	auto conf = ProblemConfig();
+	if (!conf.LoadConfig(problemPath))
+	{
+		throw std::runtime_error("Cannot parse configuration file.");
+	}
+	conf.timeSettings.CheckIsValid();
+	if (threads < 0)
+	{
+		throw std::runtime_error("Count of threads cannot be negative.");
+	}
+	if (nodeA < 0 || nodeB < 0 || nodeA >= Int32(conf.planets.size()) || nodeB >= Int32(conf.planets.size()) || nodeA == nodeB)
+	{
+		throw std::runtime_error("Porkchop nodes must be two different indices of the mission's planets.");
+	}
+
+	auto cache = Pathfinder::PlanetScript::EphemerisCache::ptr();
+	if (cachePath.size())
+	{
+		cache = Pathfinder::PlanetScript::EphemerisCache::Open(cachePath);
+	}
+
+	auto mission = conf.MakeMission(cache.get());
+	auto getScript = [&mission](Int32 i)
+	{
+		auto [asScript, asStatic] = Pathfinder::Nodes::CastNode(mission.nodes[i]);
+		if (!asScript)
+		{
+			throw std::runtime_error("Porkchop nodes must be scripted.");
+		}
+		return asScript->Script;
+	};
+
+	// \note: departures are the mission's ones: t0 + (sweep offset from [t0, t1])
+	auto& time = conf.timeSettings;
+	auto pconf = Pathfinder::Porkchop::PorkchopConfig();
+	pconf.A  = getScript(nodeA);
+	pconf.B  = getScript(nodeB);
+	pconf.GM = mission.GM;
+	pconf.t0 = time.t0 + time.t0;
+	pconf.t1 = time.t0 + time.t1;
+	pconf.dt = time.dt;
+	pconf.tof0 = tofMin;
+	pconf.tof1 = tofMax;
+	pconf.dtof = tofStep;
+	pconf.points_f0 = mission.faxConfig.points_f0;
+	pconf.timeTol = mission.faxConfig.timeTol;
+	pconf.threads = threads;
+
+	// \note: the flight times can be longer than the tail the mission's nodes were checked for
+	for (auto i : { nodeA, nodeB })
+	{
+		if (cache)
+		{
+			auto [tBegin, tEnd] = cache->GetRange(utiles::GetPlanetName(conf.planets[i].planet));
+			if (pconf.t0 < tBegin || pconf.t1 + pconf.tof1 >= tEnd)
+			{
+				throw std::runtime_error("the ephemerides cache of '" + conf.planets[i].planet + "' doesn't cover the porkchop's times");
+			}
+		}
+	}
+
+	auto grid   = Pathfinder::Porkchop::Porkchop(pconf);
+	auto writer = PorkchopWriter(outFile, grid);
+	auto rows   = grid.GetDepartures().size();
+	std::cout << " >> evaluating " << rows << "x" << grid.GetFlightTimes().size() << " porkchop with " << Parallel::GetWorkersCount(threads) << " workers..." << std::endl;
+	grid.Compute([&](size_t row, const auto& cells)
+	{
+		writer.WriteRow(row, cells);
+		std::cout << " >> processed row " << row + 1 << " of " << rows << std::endl;
+	});
+	std::cout << " >> porkchop is saved to file: " << outFile << std::endl;
+
+	return 0;
+}
+
+
+#endif //!MAIN__EXPORTPORKCHOP_HPP
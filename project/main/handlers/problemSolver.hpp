@@ -2,102 +2,89 @@
 #define MAIN__PROBLEMSOLVER_HPP
 
 #include "configs/problemConfig.hpp"
+#include "utiles/flightDB.hpp"
+#include "utiles/checkpoint.hpp"
+#include "parallel.hpp"
+#include "metrics.hpp"
 #include <filesystem>
-
-
-
-struct FlightDB : public reflect::FConfig
-{
-	ARCH_BEGIN(reflect::FConfig)
-		ARCH_FIELD(, , flights)
-		ARCH_END();
-public:
-
-	struct FlightRow : public Pathfinder::PathFinder::FlightChain
-	{
-		using Super = Pathfinder::PathFinder::FlightChain;
-
-		ARCH_BEGIN(Super)
-			ARCH_FIELD(, , functionality)
-			ARCH_END();
-	public:
-
-		FlightRow() = default;
-
-		FlightRow(const Super& rhs, FReal functionality = 0)
-			: Super(rhs)
-			, functionality(functionality)
-		{}
-
-		FReal functionality = 0;
-	};
-
-public:
-
-	std::vector<FlightRow> flights;
-
-public:
-
-	void Save(const std::string& path)
-	{
-		if (!SaveConfig(path))
-		{
-			throw std::runtime_error("Cannot save floght db to destination file: '" + path + "'");
-		}
-	}
-};
+#include <algorithm>
 
 
 
 void SaveDB(const std::string& path, const Pathfinder::PathFinder::FirstApproxDB& db)
 {
-	auto data = FlightDB();
+	auto writer = utiles::FlightWriter(path);
 	for (auto& [_, list] : db)
 	for (auto& flight : list )
 	{
-		data.flights.push_back(flight);
+		writer.Write(flight);
 	}
-	data.Save(path);
+	writer.Close();
 }
 
 void SaveDB(const std::string& path, const Pathfinder::PathFinder::SecondApproxDB& db)
 {
-	auto data = FlightDB();
+	auto writer = utiles::FlightWriter(path);
 	for (auto& [_, flight] : db)
 	{
-		data.flights.push_back({ flight.chain, flight.functionality });
+		writer.Write({ flight.chain, flight.functionality });
 	}
-	data.Save(path);
+	writer.Close();
 }
 
 
 
-int SolveProblem(const std::string& path_)
+// \note: dbFormat - extension of the result dbs: "ndjson" (text rows) or "fdb" (columnar binary)
+// \note: finished dates and SAX flights are logged to <name>.checkpoint.ndjson; with bResume the logged work
+//        isn't computed again, so a killed sweep continues and a sweep with a later t1 computes the new dates only
+// \note: a resumed sweep must keep the rest of the configuration
+// \note: SAX results are restored by their seeds, so the seeds a resumed sweep filters out don't get other seeds'
+//        results, and the seeds with no results (e.g. of new dates) are optimised
+// \note: the online filter's keep factor sees only the kept flights of restored dates, so its threshold may be
+//        lower than the one of an uninterrupted sweep
+int SolveProblem(const std::string& path_, Int32 threads = 1, const std::string& cachePath = "", const std::string& dbFormat = "ndjson", bool bResume = false)
 {
 	auto conf = ProblemConfig();
 	if (!conf.LoadConfig(path_))
 	{
 		throw std::runtime_error("Cannot parse configuration file.");
 	}
+	if (threads < 0)
+	{
+		throw std::runtime_error("Count of threads cannot be negative.");
+	}
+	if (dbFormat != "ndjson" && dbFormat != "fdb")
+	{
+		throw std::runtime_error("Unsupported flight db format: '" + dbFormat + "'.");
+	}
 
 	auto path = std::filesystem::path(path_);
 	auto dir  = path.parent_path();
 	auto name = path.stem().wstring();
-	auto faxPath = dir / (name + L".fax.json");
-	auto saxPath = dir / (name + L".sax.json");
+	auto ext  = std::filesystem::path(dbFormat).wstring();
+	auto faxPath = dir / (name + L".fax." + ext);
+	auto saxPath = dir / (name + L".sax." + ext);
+	auto metricsPath = dir / (name + L".metrics.json");
+	auto checkpointPath = dir / (name + L".checkpoint.ndjson");
+
+	auto cache = Pathfinder::PlanetScript::EphemerisCache::ptr();
+	if (cachePath.size())
+	{
+		std::cout << " >> mapping ephemerides cache: " << cachePath << std::endl;
+		cache = Pathfinder::PlanetScript::EphemerisCache::Open(cachePath);
+	}
 
-	auto solver = conf.MakeFinder();
+	Metrics::Registry::Get().Reset();
+	auto solver = conf.MakeFinder(cache.get());
+	solver.SetThreads(threads);
 	
 	auto t0 = conf.timeSettings.t0;
 	auto t1 = conf.timeSettings.t1;
 	auto dt = conf.timeSettings.dt;
+	auto offsets = std::vector<FReal>();
 	for (auto t = t0; t <= t1; t += dt)
 	{
-		auto percent = !Math::Equal(t1, t0) ? t / (t1 - t0) * 100 : 0;
-
-		std::cout << " >> processing t=" << t << " of t_max=" << t1 << " (" << percent << "%)... ";
-		auto size = solver.FirstApprox(t).size();
-		std::cout << "done (" << size << ")" << std::endl;
+		offsets.push_back(t);
 		
 		if (Math::Equal(dt, 0))
 		{
@@ -105,21 +92,100 @@ int SolveProblem(const std::string& path_)
 		}
 	}
 
-	std::cout << " >> filtering results (" << solver.FAXDBSize() << ")... ";
-	auto [min, max] = solver.GetFunctionalityBounds();
-	solver.FilterResults(min + (max - min) * conf.keepFactor);
-	std::cout << "done (" << solver.FAXDBSize() << ")" << std::endl;
+	auto checkpoint = utiles::Checkpoint();
+	if (bResume)
+	{
+		std::cout << " >> reading checkpoint log: " << checkpointPath << std::endl;
+		checkpoint = utiles::Checkpoint::Read(checkpointPath.string());
+	}
+	auto log = utiles::CheckpointWriter(checkpointPath.string(), bResume);
+
+	// \note: the logged dates precede the new ones, so all the dates are merged in their order
+	constexpr auto offsetTol = FReal(1.e-3);
+	auto newOffsets = std::vector<FReal>();
+	for (auto t : offsets)
+	{
+		auto pos = checkpoint.firstApprox.lower_bound(t - offsetTol);
+		if (pos != checkpoint.firstApprox.end() && pos->first <= t + offsetTol)
+		{
+			solver.RestoreFirstApprox(t, std::move(pos->second));
+			continue;
+		}
+		newOffsets.push_back(t);
+	}
+	if (newOffsets.size() < offsets.size())
+	{
+		std::cout << " >> restored " << offsets.size() - newOffsets.size() << " launch dates (" << solver.FAXDBSize() << ")" << std::endl;
+	}
+
+	std::cout << " >> processing " << newOffsets.size() << " launch dates with " << Parallel::GetWorkersCount(threads) << " workers..." << std::endl;
+	solver.FirstApprox(newOffsets, threads, [t0, t1, &log](FReal t, const auto& flights)
+	{
+		log.WriteFirstApprox(t, flights);
+		auto percent = !Math::Equal(t1, t0) ? t / (t1 - t0) * 100 : 0;
+		std::cout << " >> processed t=" << t << " of t_max=" << t1 << " (" << percent << "%)... done (" << flights.size() << ")" << std::endl;
+	});
+
+	if (auto stats = solver.GetLegCacheStats(); stats.hits + stats.misses)
+	{
+		std::cout << " >> leg cache: " << stats.hits << " hits, " << stats.misses << " misses, " 
+			<< stats.entries << " legs (" << stats.bytes / 1024 << " KB), " << stats.refused << " refused" << std::endl;
+	}
+
+	if (auto pruned = solver.GetPrunedCount())
+	{
+		std::cout << " >> branch and bound: " << pruned << " flights pruned" << std::endl;
+	}
+
+	if (!conf.onlineFilter)
+	{
+		std::cout << " >> filtering results (" << solver.FAXDBSize() << ")... ";
+		auto [min, max] = solver.GetFunctionalityBounds();
+		solver.FilterResults(min + (max - min) * conf.keepFactor);
+		if (conf.keepTopK > 0)
+		{
+			solver.KeepBestResults(size_t(conf.keepTopK));
+		}
+		std::cout << "done (" << solver.FAXDBSize() << ")" << std::endl;
+	}
 	
+	if (conf.clusterTime > 0 && conf.clusterAngle > 0)
+	{
+		std::cout << " >> clustering results (" << solver.FAXDBSize() << ")... ";
+		solver.ClusterResults({ conf.clusterTime, conf.clusterAngle });
+		std::cout << "done (" << solver.FAXDBSize() << ")" << std::endl;
+	}
+
 	std::cout << " >> saving results (" << solver.FAXDBSize() << ") to file: " << faxPath << std::endl;
 	SaveDB(faxPath.string(), solver.GetFirstApproxDB());
 	
+	if (checkpoint.secondApprox.size())
+	{
+		std::cout << " >> restored " << checkpoint.secondApprox.size() << " optimised results" << std::endl;
+		for (auto& [seed, result] : checkpoint.secondApprox)
+		{
+			solver.RestoreSecondApprox(seed, std::move(result));
+		}
+	}
+
 	std::cout << " >> optimisating results (" << solver.FAXDBSize() << ")... ";
-	solver.SecondApprox();
+	solver.SecondApprox([&log](const auto& seed, const auto& result)
+	{
+		log.WriteSecondApprox(seed, result);
+	});
 	std::cout << "done (" << solver.SAXDBSize() << ")" << std::endl;
 
 	std::cout << " >> saving results (" << solver.SAXDBSize() << ") to file: " << saxPath << std::endl;
 	SaveDB(saxPath.string(), solver.GetSecondApproxDB());
 
+	std::cout << " >> saving metrics to file: " << metricsPath << std::endl;
+	auto metrics = std::ofstream(metricsPath);
+	Metrics::Registry::Get().Collect().WriteJSON(metrics);
+	if (!metrics)
+	{
+		throw std::runtime_error("Cannot save metrics to destination file: '" + metricsPath.string() + "'");
+	}
+
 	return 0;
 }
 
@@ -2,33 +2,64 @@
 #define MAIN__TRACETRAJECTORY_HPP
 
 #include "pathfinder.hpp"
+#include "utiles/flightColumns.hpp"
 #include <filesystem>
 #include <iostream>
 #include <fstream>
 
 
 
-int TraceTrajectory(std::string outPath, std::string path, FReal fraction)
+// \note: index < 0 - the path is a single trajectory, else - the path is a flight db (*.ndjson, *.fdb or legacy *.json)
+int TraceTrajectory(std::string outPath, std::string path, FReal fraction, Int32 index = -1)
 {
-	auto is = std::ifstream(path);
-	if (!is)
+	if (index < 0 && (utiles::IsNDJSON(path) || utiles::FlightColumns::IsFDB(path)))
 	{
-		throw std::runtime_error("Passed trajectory path cannot be opend");
+		index = 0;
 	}
 
-	auto os = std::ofstream(outPath);
-	if (!os)
+	auto chain = Pathfinder::PathFinder::FlightRecord();
+	if (index < 0)
 	{
-		throw std::runtime_error("Passed output path cannot be opend");
-	}
+		auto is = std::ifstream(path);
+		if (!is)
+		{
+			throw std::runtime_error("Passed trajectory path cannot be opend");
+		}
 
-	auto chain = Pathfinder::PathFinder::FlightChain();
-	{
 		auto ar = reflect::Archiver();
 		ar.Load(std::string(std::istreambuf_iterator(is), {}));
 		
 		chain.Unmarshal(ar);
 	}
+	else if (utiles::FlightColumns::IsFDB(path))
+	{
+		// \note: the db is mapped, so only the requested chain is read
+		auto reader = utiles::FlightColumnsReader(path);
+		if (size_t(index) >= reader.GetChainsCount())
+		{
+			throw std::runtime_error("Passed flight db has no trajectory " + std::to_string(index));
+		}
+		chain = reader.GetChain(size_t(index));
+	}
+	else
+	{
+		auto reader = utiles::FlightReader(path);
+		auto row    = FlightDB::FlightRow();
+		for (auto i = 0; i <= index; ++i)
+		{
+			if (!reader.Next(row))
+			{
+				throw std::runtime_error("Passed flight db has no trajectory " + std::to_string(index));
+			}
+		}
+		chain = std::move(row);
+	}
+
+	auto os = std::ofstream(outPath);
+	if (!os)
+	{
+		throw std::runtime_error("Passed output path cannot be opend");
+	}
 
 	auto points = std::vector<FVector>();
 	for (const auto& link : chain.chain)
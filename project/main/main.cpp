@@ -4,6 +4,8 @@
 #include "handlers/traceTrajectory.hpp"
 #include "handlers/tracePlanet.hpp"
 #include "handlers/problemSolver.hpp"
+#include "handlers/buildEphemCache.hpp"
+#include "handlers/exportPorkchop.hpp"
 #include "planetScript.hpp"
 
 #include <gflags/gflags.h>
@@ -14,9 +16,22 @@ DEFINE_string(coreConfPath, "./core.json", "path to pathfinder core configuratio
 DEFINE_string(f           , ""           , "path to mission config");
 DEFINE_string(makeProbConf, ""           , "path to make default mission configuration file");
 DEFINE_string(makeCoreConf, ""           , "path to make core configuration file");
+DEFINE_int32 (threads     , 1            , "count of workers to run computations with (0 - one per hardware thread)");
+DEFINE_string(buildEphemCache, ""        , "path to write an ephemerides cache of the mission's bodies to (requires -f)");
+DEFINE_string(ephemCache  , ""           , "path to an ephemerides cache to be used instead of SPICE kernels");
+DEFINE_string(dbFormat    , "ndjson"     , "format of result flight dbs: ndjson - text rows, fdb - columnar binary");
+DEFINE_bool  (resume      , false        , "skips the work logged to the mission's checkpoint log (requires -f)");
+
+DEFINE_string(porkchop , ""  , "path to write a porkchop grid of a leg of the mission to (*.csv - text, else - binary; requires -f)");
+DEFINE_int32 (porkchopA, 0   , "index of the leg's departure planet in the mission");
+DEFINE_int32 (porkchopB, 1   , "index of the leg's arrival planet in the mission");
+DEFINE_double(tofMin   , 0   , "[s] - porkchop's min flight time");
+DEFINE_double(tofMax   , 0   , "[s] - porkchop's max flight time");
+DEFINE_double(tofStep  , 0   , "[s] - porkchop's flight time step");
 
 DEFINE_string(tracePath, "", "");
 DEFINE_double(taceFraction, 0.1, "");
+DEFINE_int32 (traceIndex, -1, "index of a trajectory in a flight db passed as tracePath (-1 - tracePath is a single trajectory)");
 DEFINE_string(tracePlanet, "", "");
 DEFINE_string(traceOrigin, "", "");
 DEFINE_double(traceBgn, 0, "");
@@ -33,6 +48,10 @@ int main(int argc, char** argv)
 		"[ -f=\"path_to_problem_conf.json\" ] \n"
 		"[ -makeProbConf=\"path_to_conf\"   ] \n"
 		"[ -makeCoreConf=\"path_to_conf\"   ] \n"
+		"[ -threads=N                      ] \n"
+		"[ -buildEphemCache=\"path_to_cache\" ] \n"
+		"[ -ephemCache=\"path_to_cache\"      ] \n"
+		"[ -porkchop=\"path_to_grid\" -porkchopA=i -porkchopB=j -tofMin=s -tofMax=s -tofStep=s ] \n"
 	);
 
 	if (argc == 1)
@@ -54,7 +73,16 @@ int main(int argc, char** argv)
 		}
 		if (FLAGS_o.size() && FLAGS_tracePath.size() && FLAGS_taceFraction > 0 && FLAGS_taceFraction <= 1)
 		{
-			return TraceTrajectory(FLAGS_o, FLAGS_tracePath, FLAGS_taceFraction);
+			return TraceTrajectory(FLAGS_o, FLAGS_tracePath, FLAGS_taceFraction, FLAGS_traceIndex);
+		}
+		if (FLAGS_f.size() && FLAGS_ephemCache.size() && FLAGS_porkchop.size())
+		{
+			return ExportPorkchop(FLAGS_porkchop, FLAGS_f, FLAGS_porkchopA, FLAGS_porkchopB, FLAGS_tofMin, FLAGS_tofMax, FLAGS_tofStep, FLAGS_threads, FLAGS_ephemCache);
+		}
+		if (FLAGS_f.size() && FLAGS_ephemCache.size())
+		{
+			// \note: the cache replaces the kernels, so they aren't loaded at all
+			return SolveProblem(FLAGS_f, FLAGS_threads, FLAGS_ephemCache, FLAGS_dbFormat, FLAGS_resume);
 		}
 		
 		auto mainConfig = MainConfig();
@@ -72,9 +100,17 @@ int main(int argc, char** argv)
 			return TracePlanet(FLAGS_o, FLAGS_tracePlanet, FLAGS_traceOrigin, FLAGS_traceBgn, FLAGS_traceEnd, FLAGS_traceStep);
 		}
 
+		if (FLAGS_f.size() && FLAGS_porkchop.size())
+		{
+			return ExportPorkchop(FLAGS_porkchop, FLAGS_f, FLAGS_porkchopA, FLAGS_porkchopB, FLAGS_tofMin, FLAGS_tofMax, FLAGS_tofStep, FLAGS_threads);
+		}
+		if (FLAGS_f.size() && FLAGS_buildEphemCache.size())
+		{
+			return BuildEphemCache(FLAGS_buildEphemCache, FLAGS_f);
+		}
 		if (FLAGS_f.size())
 		{
-			return SolveProblem(FLAGS_f);
+			return SolveProblem(FLAGS_f, FLAGS_threads, "", FLAGS_dbFormat, FLAGS_resume);
 		}
 		
 		gflags::ShowUsageWithFlags(argv[0]);
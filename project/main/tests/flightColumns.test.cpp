@@ -0,0 +1,154 @@
+#include "gtest/gtest.h"
+#include "utiles/flightColumns.hpp"
+#include <filesystem>
+#include <cstring>
+
+
+
+struct flightColumns_tests : public testing::Test
+{
+	using FlightRow = FlightDB::FlightRow;
+
+	static std::string GetPath()
+	{
+		return (std::filesystem::temp_directory_path() / "flightColumns_tests.fdb").string();
+	}
+
+	// a row with distinct values in all the columns
+	static FlightRow MakeRow(size_t infos, FReal seed)
+	{
+		auto row = FlightRow();
+		row.chain.resize(infos);
+
+		auto value = seed;
+#define FLIGHT_DB_FILL(name, field) field = std::remove_reference_t<decltype(field)>(value += 1);
+		FLIGHT_DB_CHAIN_COLUMNS(FLIGHT_DB_FILL)
+		for (auto& info : row.chain)
+		{
+			FLIGHT_DB_INFO_COLUMNS(FLIGHT_DB_FILL)
+		}
+#undef FLIGHT_DB_FILL
+		return row;
+	}
+
+	// values of all the row's columns
+	static std::vector<FReal> GetValues(const FlightRow& row)
+	{
+		auto values = std::vector<FReal>();
+#define FLIGHT_DB_GET(name, field) values.push_back(FReal(field));
+		FLIGHT_DB_CHAIN_COLUMNS(FLIGHT_DB_GET)
+		for (auto& info : row.chain)
+		{
+			FLIGHT_DB_INFO_COLUMNS(FLIGHT_DB_GET)
+		}
+#undef FLIGHT_DB_GET
+		return values;
+	}
+
+	static std::vector<FlightRow> WriteRows(const std::string& path)
+	{
+		auto rows = std::vector<FlightRow>{ MakeRow(2, 0), MakeRow(0, 1000), MakeRow(3, 2000) };
+		auto writer = utiles::FlightColumnsWriter(path);
+		for (auto& row : rows)
+		{
+			writer.Write(row);
+		}
+		writer.Close();
+		return rows;
+	}
+
+	// rewrites a part of the file in place
+	template<typename T>
+	static void Patch(const std::string& path, UInt64 offset, const T& value)
+	{
+		auto file = std::fstream(path, std::ios::binary | std::ios::in | std::ios::out);
+		file.seekp(offset);
+		file.write(reinterpret_cast<const char*>(&value), sizeof(value));
+	}
+};
+
+
+TEST_F(flightColumns_tests, roundTrip)
+{
+	auto path = GetPath();
+	auto rows = WriteRows(path);
+	{
+		auto reader = utiles::FlightColumnsReader(path);
+		ASSERT_EQ(reader.GetChainsCount(), rows.size());
+		ASSERT_EQ(reader.GetInfosCount(), 5);
+		for (size_t i = 0; i < rows.size(); ++i)
+		{
+			auto [begin, end] = reader.GetInfos(i);
+			EXPECT_EQ(end - begin, rows[i].chain.size());
+			EXPECT_EQ(GetValues(reader.GetChain(i)), GetValues(rows[i])) << i;
+		}
+		EXPECT_EQ(reader.GetColumn(utiles::FlightColumns::eChain_clusterSize)[2], rows[2].clusterSize);
+		EXPECT_THROW(reader.GetChain(rows.size()), std::out_of_range);
+	}
+
+	// the streaming reader reads the same rows
+	auto reader = utiles::FlightReader(path);
+	auto row = FlightRow();
+	for (auto& expected : rows)
+	{
+		ASSERT_TRUE(reader.Next(row));
+		EXPECT_EQ(GetValues(row), GetValues(expected));
+	}
+	EXPECT_FALSE(reader.Next(row));
+	std::filesystem::remove(path);
+}
+
+TEST_F(flightColumns_tests, optionalColumn)
+{
+	// a file written before clusterSize was added has no such column
+	using utiles::FlightColumns;
+	auto path = GetPath();
+	auto rows = WriteRows(path);
+	auto column = FlightColumns::Column();
+	std::strncpy(column.name, "removed", sizeof(column.name));
+	auto entry  = sizeof(FlightColumns::Header) + sizeof(FlightColumns::Column) * FlightColumns::eChain_clusterSize;
+	Patch(path, entry, column.name);
+
+	auto reader = utiles::FlightColumnsReader(path);
+	EXPECT_EQ(reader.GetColumn(FlightColumns::eChain_clusterSize), nullptr);
+	for (size_t i = 0; i < rows.size(); ++i)
+	{
+		auto row = reader.GetChain(i);
+		EXPECT_EQ(row.clusterSize, 1);
+		row.clusterSize = rows[i].clusterSize;
+		EXPECT_EQ(GetValues(row), GetValues(rows[i])) << i;
+	}
+
+	// a required column can't be missed
+	Patch(path, entry - sizeof(FlightColumns::Column), column.name);
+	EXPECT_THROW(utiles::FlightColumnsReader{ path }, std::runtime_error);
+	std::filesystem::remove(path);
+}
+
+TEST_F(flightColumns_tests, corruptedFiles)
+{
+	using utiles::FlightColumns;
+	auto path = GetPath();
+	WriteRows(path);
+	auto size = std::filesystem::file_size(path);
+
+	// the last entry of the chain index must be the count of infos
+	auto header = FlightColumns::Header();
+	std::ifstream(path, std::ios::binary).read(reinterpret_cast<char*>(&header), sizeof(header));
+	Patch(path, header.indexOffset + sizeof(UInt64) * header.chainsCount, UInt64(4));
+	EXPECT_THROW(utiles::FlightColumnsReader{ path }, std::runtime_error);
+
+	// the index is out of a truncated file
+	WriteRows(path);
+	std::filesystem::resize_file(path, size - sizeof(UInt64));
+	EXPECT_THROW(utiles::FlightColumnsReader{ path }, std::runtime_error);
+
+	// the column directory is out of a truncated file
+	std::filesystem::resize_file(path, sizeof(FlightColumns::Header) + sizeof(FlightColumns::Column));
+	EXPECT_THROW(utiles::FlightColumnsReader{ path }, std::runtime_error);
+
+	// a foreign file
+	std::ofstream(path, std::ios::trunc) << "not a flight db, but long enough to have a header of the file format";
+	EXPECT_THROW(utiles::FlightColumnsReader{ path }, std::runtime_error);
+	std::filesystem::remove(path);
+}
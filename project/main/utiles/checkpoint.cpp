@@ -0,0 +1,129 @@
+#include "checkpoint.hpp"
+#include <filesystem>
+#include <algorithm>
+
+
+
+namespace utiles
+{
+	Checkpoint Checkpoint::Read(const std::string& path)
+	{
+		auto checkpoint = Checkpoint();
+		if (!std::filesystem::exists(path))
+		{
+			return checkpoint;
+		}
+
+		auto is = std::ifstream(path);
+		if (!is)
+		{
+			throw std::runtime_error("Cannot open checkpoint log: '" + path + "'");
+		}
+
+		auto line = std::string();
+		while (std::getline(is, line))
+		{
+			// \note: getline hits the end of the file only on a line without its line break
+			if (is.eof() || line.find_first_not_of(" \t\r") == std::string::npos)
+			{
+				continue;
+			}
+
+			auto ar = reflect::Archiver();
+			if (!ar.Load(line))
+			{
+				throw std::runtime_error("Cannot parse checkpoint log: '" + path + "'");
+			}
+			auto record = CheckpointRecord();
+			record.Unmarshal(ar);
+
+			if (record.type == "fax")
+			{
+				auto& flights = checkpoint.firstApprox[record.timeOffset];
+				flights.clear();
+				for (auto& flight : record.flights)
+				{
+					flights.push_back(flight.ToChain());
+				}
+				continue;
+			}
+			if (record.type != "sax" || record.flights.empty())
+			{
+				throw std::runtime_error("Invalid record '" + record.type + "' in checkpoint log: '" + path + "'");
+			}
+
+			auto& [seed, result] = checkpoint.secondApprox.emplace_back(record.flights.front().ToChain(), std::nullopt);
+			if (record.flights.size() > 1)
+			{
+				result = SecondApproxData{ record.flights.back().ToChain(), record.functionality, UInt64(record.evaluations) };
+			}
+		}
+		return checkpoint;
+	}
+
+
+	CheckpointWriter::CheckpointWriter(const std::string& path, bool bAppend)
+		: path(path)
+	{
+		// \note: a line a killed run didn't finish is closed, so the next record starts on its own line
+		auto bTorn = false;
+		if (bAppend && std::filesystem::exists(path) && std::filesystem::file_size(path))
+		{
+			auto is = std::ifstream(path, std::ios::binary);
+			is.seekg(-1, std::ios::end);
+			bTorn = is.get() != '\n';
+		}
+
+		os.open(path, bAppend ? std::ios::app : std::ios::trunc);
+		if (!os)
+		{
+			throw std::runtime_error("Cannot open checkpoint log on write: '" + path + "'");
+		}
+		if (bTorn)
+		{
+			os << '\n';
+		}
+	}
+
+	void CheckpointWriter::WriteFirstApprox(FReal timeOffset, const std::vector<FlightChain>& flights)
+	{
+		auto record = CheckpointRecord();
+		record.type = "fax";
+		record.timeOffset = timeOffset;
+		record.flights.assign(flights.begin(), flights.end());
+		Write(record);
+	}
+
+	void CheckpointWriter::WriteSecondApprox(const FlightChain& seed, const std::optional<SecondApproxData>& result)
+	{
+		auto record = CheckpointRecord();
+		record.type = "sax";
+		record.flights.emplace_back(seed);
+		if (result)
+		{
+			record.functionality = result->functionality;
+			record.evaluations = FReal(result->evaluations);
+			record.flights.emplace_back(result->chain);
+		}
+		Write(record);
+	}
+
+	void CheckpointWriter::Write(const CheckpointRecord& record)
+	{
+		auto ar = reflect::Archiver();
+		record.Marshal(ar);
+
+		// \note: raw line breaks can be only between JSON tokens, so dropping them keeps the record valid
+		auto data = ar.Save();
+		data.erase(std::remove_if(data.begin(), data.end(), [](char c)
+		{
+			return c == '\n' || c == '\r';
+		}), data.end());
+
+		os << data << '\n' << std::flush;
+		if (!os)
+		{
+			throw std::runtime_error("Cannot write to checkpoint log: '" + path + "'");
+		}
+	}
+}
@@ -0,0 +1,73 @@
+#ifndef MAIN__CHECKPOINT_HPP
+#define MAIN__CHECKPOINT_HPP
+
+#include <boost/noncopyable.hpp>
+#include "pathfinder.hpp"
+#include "reflect/config.hpp"
+#include <fstream>
+
+
+
+// CheckpointRecord is a line of a checkpoint log: a date's FAX flights or a SAX result
+struct CheckpointRecord : public reflect::FArchived
+{
+	using FlightRecord = Pathfinder::PathFinder::FlightRecord;
+
+	ARCH_BEGIN(reflect::FArchived)
+		ARCH_FIELD(, , type)
+		ARCH_FIELD(, , timeOffset)
+		ARCH_FIELD(, , functionality)
+		ARCH_FIELD(, , evaluations)
+		ARCH_FIELD(, , flights)
+		ARCH_END();
+public:
+
+	std::string type;        // "fax" or "sax"
+	FReal timeOffset = 0;    // fax - the date's time offset
+	FReal functionality = 0; // sax
+	FReal evaluations = 0;   // sax
+	std::vector<FlightRecord> flights; // fax - the date's flights, sax - the seed and the optimised flight (if any)
+};
+
+
+namespace utiles
+{
+	// Checkpoint is the work a checkpoint log holds
+	struct Checkpoint
+	{
+		using FlightChain      = Pathfinder::PathFinder::FlightChain;
+		using SecondApproxData = Pathfinder::PathFinder::SecondApproxData;
+
+		std::map<FReal, std::vector<FlightChain>> firstApprox; // by time offsets
+		std::vector<std::tuple<FlightChain, std::optional<SecondApproxData>>> secondApprox; // by seeds
+
+		// reads a log; a missing log is an empty checkpoint
+		// \note: an unterminated last line is the one a killed run didn't finish, so it's ignored
+		static Checkpoint Read(const std::string& path);
+	};
+
+	// CheckpointWriter appends records of finished work to a NDJSON log, so a killed sweep can be resumed
+	// \note: each record is flushed as it's written
+	class CheckpointWriter final : boost::noncopyable
+	{
+	public:
+		using FlightChain      = Pathfinder::PathFinder::FlightChain;
+		using SecondApproxData = Pathfinder::PathFinder::SecondApproxData;
+
+		// \note: the log is truncated unless bAppend is set
+		CheckpointWriter(const std::string& path, bool bAppend);
+
+		void WriteFirstApprox(FReal timeOffset, const std::vector<FlightChain>& flights);
+		void WriteSecondApprox(const FlightChain& seed, const std::optional<SecondApproxData>& result);
+
+	private:
+		void Write(const CheckpointRecord& record);
+
+	private:
+		std::string path;
+		std::ofstream os;
+	};
+}
+
+
+#endif //!MAIN__CHECKPOINT_HPP
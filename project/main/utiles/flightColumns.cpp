@@ -0,0 +1,304 @@
+#include "flightColumns.hpp"
+#include <boost/interprocess/file_mapping.hpp>
+#include <boost/interprocess/mapped_region.hpp>
+#include <filesystem>
+#include <cstring>
+
+
+
+namespace utiles
+{
+	namespace
+	{
+		constexpr char fdbMagic[8] = { 'G', 'A', 'F', 'L', 'T', 'D', 'B', '\0' };
+
+#define FLIGHT_DB_NAME(name, field) #name,
+		constexpr const char* chainColumnNames[] = { FLIGHT_DB_CHAIN_COLUMNS(FLIGHT_DB_NAME) };
+		constexpr const char* infoColumnNames [] = { FLIGHT_DB_INFO_COLUMNS (FLIGHT_DB_NAME) };
+#undef FLIGHT_DB_NAME
+
+		UInt64 Align(UInt64 offset)
+		{
+			return (offset + FlightColumns::alignment - 1) / FlightColumns::alignment * FlightColumns::alignment;
+		}
+
+		FlightColumns::Column MakeColumn(const char* name, UInt64 offset)
+		{
+			auto column = FlightColumns::Column();
+			std::memset(column.name, 0, sizeof(column.name));
+			std::strncpy(column.name, name, sizeof(column.name) - 1);
+			column.offset = offset;
+			return column;
+		}
+
+		template<typename T>
+		void Assign(T& field, FReal value)
+		{
+			field = static_cast<T>(value);
+		}
+	}
+
+
+	bool FlightColumns::IsFDB(const std::string& path)
+	{
+		return std::filesystem::path(path).extension() == ".fdb";
+	}
+
+	bool FlightColumns::IsOptional(EChainColumn column)
+	{
+		return column == eChain_clusterSize;
+	}
+
+
+	FlightColumnsWriter::FlightColumnsWriter(const std::string& path)
+		: path(path)
+	{}
+
+	void FlightColumnsWriter::Write(const FlightDB::FlightRow& row)
+	{
+		auto column = size_t(0);
+#define FLIGHT_DB_PUSH(name, field) chainColumns[column++].push_back(FReal(field));
+		FLIGHT_DB_CHAIN_COLUMNS(FLIGHT_DB_PUSH)
+#undef FLIGHT_DB_PUSH
+
+		for (auto& info : row.chain)
+		{
+			column = 0;
+#define FLIGHT_DB_PUSH(name, field) infoColumns[column++].push_back(FReal(field));
+			FLIGHT_DB_INFO_COLUMNS(FLIGHT_DB_PUSH)
+#undef FLIGHT_DB_PUSH
+		}
+		index.push_back(index.back() + row.chain.size());
+	}
+
+	void FlightColumnsWriter::Close()
+	{
+		if (bClosed)
+		{
+			return;
+		}
+		bClosed = true;
+
+		auto chainsCount = UInt64(index.size() - 1);
+		auto infosCount  = index.back();
+
+		auto header = FlightColumns::Header();
+		std::memcpy(header.magic, fdbMagic, sizeof(header.magic));
+		header.version = FlightColumns::version;
+		header.realSize = sizeof(FReal);
+		header.chainsCount = chainsCount;
+		header.infosCount = infosCount;
+		header.chainColumnsCount = FlightColumns::eChainColumnsCount;
+		header.infoColumnsCount = FlightColumns::eInfoColumnsCount;
+
+		auto columns = std::vector<FlightColumns::Column>();
+		auto offset  = Align(sizeof(header) + sizeof(FlightColumns::Column) * (header.chainColumnsCount + header.infoColumnsCount));
+		for (auto name : chainColumnNames)
+		{
+			columns.push_back(MakeColumn(name, offset));
+			offset = Align(offset + sizeof(FReal) * chainsCount);
+		}
+		for (auto name : infoColumnNames)
+		{
+			columns.push_back(MakeColumn(name, offset));
+			offset = Align(offset + sizeof(FReal) * infosCount);
+		}
+		header.indexOffset = offset;
+
+		auto file = std::ofstream(path, std::ios::binary | std::ios::trunc);
+		auto pad  = [&file](UInt64 offset)
+		{
+			static const char zeros[FlightColumns::alignment] = {};
+			file.write(zeros, offset - UInt64(file.tellp()));
+		};
+		auto write = [&file](const auto& data)
+		{
+			file.write(reinterpret_cast<const char*>(data.data()), sizeof(data[0]) * data.size());
+		};
+
+		file.write(reinterpret_cast<const char*>(&header), sizeof(header));
+		write(columns);
+		for (size_t i = 0; i < chainColumns.size(); ++i)
+		{
+			pad(columns[i].offset);
+			write(chainColumns[i]);
+		}
+		for (size_t i = 0; i < infoColumns.size(); ++i)
+		{
+			pad(columns[chainColumns.size() + i].offset);
+			write(infoColumns[i]);
+		}
+		pad(header.indexOffset);
+		write(index);
+
+		file.close();
+		if (!file)
+		{
+			throw std::runtime_error("Cannot save flight db to destination file: '" + path + "'");
+		}
+	}
+
+	size_t FlightColumnsWriter::GetCount() const
+	{
+		return index.size() - 1;
+	}
+
+
+	struct FlightColumnsReader::Mapping
+	{
+		boost::interprocess::file_mapping  file;
+		boost::interprocess::mapped_region region;
+	};
+
+	FlightColumnsReader::FlightColumnsReader(const std::string& path)
+		: path(path)
+		, mapping(std::make_unique<Mapping>())
+	{
+		namespace bip = boost::interprocess;
+
+		try
+		{
+			mapping->file   = bip::file_mapping(path.c_str(), bip::read_only);
+			mapping->region = bip::mapped_region(mapping->file, bip::read_only);
+		}
+		catch (const bip::interprocess_exception& e)
+		{
+			throw std::runtime_error("Cannot map flight db '" + path + "': " + e.what());
+		}
+
+		auto begin = static_cast<const char*>(mapping->region.get_address());
+		auto size  = UInt64(mapping->region.get_size());
+		auto error = [&path](const std::string& reason)
+		{
+			return std::runtime_error("Invalid flight db '" + path + "': " + reason);
+		};
+		auto check = [&](UInt64 offset, UInt64 count, UInt64 itemSize, const std::string& what)
+		{
+			if (offset % FlightColumns::alignment != 0
+			 || offset > size
+			 || count > (size - offset) / itemSize
+			) {
+				throw error(what + " is out of the file");
+			}
+		};
+
+		if (size < sizeof(FlightColumns::Header))
+		{
+			throw error("the file is too short");
+		}
+		header = reinterpret_cast<const FlightColumns::Header*>(begin);
+		if (std::memcmp(header->magic, fdbMagic, sizeof(fdbMagic)) != 0)
+		{
+			throw error("unknown file format");
+		}
+		if (header->version != FlightColumns::version)
+		{
+			throw error("unsupported schema version " + std::to_string(header->version));
+		}
+		if (header->realSize != sizeof(FReal))
+		{
+			throw error("unsupported real size " + std::to_string(header->realSize));
+		}
+
+		auto columnsCount = UInt64(header->chainColumnsCount) + header->infoColumnsCount;
+		if (columnsCount > (size - sizeof(FlightColumns::Header)) / sizeof(FlightColumns::Column))
+		{
+			throw error("the column directory is truncated");
+		}
+		auto columns = reinterpret_cast<const FlightColumns::Column*>(begin + sizeof(FlightColumns::Header));
+		auto find = [&](const char* name, UInt64 first, UInt64 last, UInt64 count, bool bOptional = false)
+		{
+			for (auto i = first; i < last; ++i)
+			{
+				if (std::strncmp(columns[i].name, name, sizeof(columns[i].name)) == 0)
+				{
+					check(columns[i].offset, count, sizeof(FReal), std::string("the column '") + name + "'");
+					return reinterpret_cast<const FReal*>(begin + columns[i].offset);
+				}
+			}
+			if (bOptional)
+			{
+				return (const FReal*)nullptr;
+			}
+			throw error(std::string("the column '") + name + "' is missed");
+		};
+
+		for (size_t i = 0; i < chainColumns.size(); ++i)
+		{
+			chainColumns[i] = find(chainColumnNames[i], 0, header->chainColumnsCount, header->chainsCount
+				, FlightColumns::IsOptional(FlightColumns::EChainColumn(i)));
+		}
+		for (size_t i = 0; i < infoColumns.size(); ++i)
+		{
+			infoColumns[i] = find(infoColumnNames[i], header->chainColumnsCount, columnsCount, header->infosCount);
+		}
+
+		if (header->chainsCount == std::numeric_limits<UInt64>::max())
+		{
+			throw error("the chain index is corrupted");
+		}
+		check(header->indexOffset, header->chainsCount + 1, sizeof(UInt64), "the chain index");
+		index = reinterpret_cast<const UInt64*>(begin + header->indexOffset);
+		if (index[0] != 0 || index[header->chainsCount] != header->infosCount)
+		{
+			throw error("the chain index is corrupted");
+		}
+	}
+
+	FlightColumnsReader::~FlightColumnsReader() = default;
+
+	size_t FlightColumnsReader::GetChainsCount() const
+	{
+		return size_t(header->chainsCount);
+	}
+
+	size_t FlightColumnsReader::GetInfosCount() const
+	{
+		return size_t(header->infosCount);
+	}
+
+	const FReal* FlightColumnsReader::GetColumn(FlightColumns::EChainColumn column) const
+	{
+		return chainColumns[column];
+	}
+
+	const FReal* FlightColumnsReader::GetColumn(FlightColumns::EInfoColumn column) const
+	{
+		return infoColumns[column];
+	}
+
+	auto FlightColumnsReader::GetInfos(size_t chain) const -> std::tuple<size_t, size_t>
+	{
+		if (chain >= GetChainsCount())
+		{
+			throw std::out_of_range("there is no chain " + std::to_string(chain) + " in '" + path + "'");
+		}
+		auto begin = index[chain];
+		auto end   = index[chain + 1];
+		if (begin > end || end > header->infosCount)
+		{
+			throw std::runtime_error("Invalid flight db '" + path + "': the chain index is corrupted");
+		}
+		return { size_t(begin), size_t(end) };
+	}
+
+	auto FlightColumnsReader::GetChain(size_t chain) const -> FlightDB::FlightRow
+	{
+		auto [begin, end] = GetInfos(chain);
+
+		auto row = FlightDB::FlightRow();
+#define FLIGHT_DB_READ(name, field) if (auto column = chainColumns[FlightColumns::eChain_##name]) Assign(field, column[chain]);
+		FLIGHT_DB_CHAIN_COLUMNS(FLIGHT_DB_READ)
+#undef FLIGHT_DB_READ
+
+		row.chain.resize(end - begin);
+		for (auto i = begin; i < end; ++i)
+		{
+			auto& info = row.chain[i - begin];
+#define FLIGHT_DB_READ(name, field) Assign(field, infoColumns[FlightColumns::eInfo_##name][i]);
+			FLIGHT_DB_INFO_COLUMNS(FLIGHT_DB_READ)
+#undef FLIGHT_DB_READ
+		}
+		return row;
+	}
+}
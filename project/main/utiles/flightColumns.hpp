@@ -0,0 +1,149 @@
+#ifndef MAIN__FLIGHTCOLUMNS_HPP
+#define MAIN__FLIGHTCOLUMNS_HPP
+
+#include "utiles/flightDB.hpp"
+#include <array>
+
+
+
+// columns of flight chains: X(name, field of a FlightDB::FlightRow 'row')
+#define FLIGHT_DB_CHAIN_COLUMNS(X)	\
+	X(functionality	, row.functionality	)	\
+	X(Correction	, row.Correction	)	\
+	X(Mismatch		, row.Mismatch		)	\
+	X(Impulse		, row.Impulse		)	\
+	X(totalTime		, row.totalTime		)	\
+	X(startTime		, row.startTime		)	\
+	X(clusterSize	, row.clusterSize	)	\
+/**/
+
+// columns of chains' links: X(name, field of a PathFinder::FlightInfo 'info')
+#define FLIGHT_DB_INFO_COLUMNS(X)	\
+	X(totalCorrection	, info.totalCorrection	)	\
+	X(totalMismatch		, info.totalMismatch	)	\
+	X(totalImpulse		, info.totalImpulse		)	\
+	X(totalTime			, info.totalTime		)	\
+	X(absTime			, info.absTime			)	\
+	X(R0x, info.link.R0.x) X(R0y, info.link.R0.y) X(R0z, info.link.R0.z)	\
+	X(R1x, info.link.R1.x) X(R1y, info.link.R1.y) X(R1z, info.link.R1.z)	\
+	X(V0x, info.link.V0.x) X(V0y, info.link.V0.y) X(V0z, info.link.V0.z)	\
+	X(V1x, info.link.V1.x) X(V1y, info.link.V1.y) X(V1z, info.link.V1.z)	\
+	X(W0x, info.link.W0.x) X(W0y, info.link.W0.y) X(W0z, info.link.W0.z)	\
+	X(W1x, info.link.W1.x) X(W1y, info.link.W1.y) X(W1z, info.link.W1.z)	\
+	X(r0, info.link.r0) X(r1, info.link.r1)	\
+	X(f0, info.link.f0) X(f1, info.link.f1)	\
+	X(v0, info.link.v0) X(v1, info.link.v1)	\
+	X(t0, info.link.t0) X(t1, info.link.t1)	\
+	X(Q0, info.link.Q0) X(Q1, info.link.Q1)	\
+	X(q0, info.link.q0) X(q1, info.link.q1)	\
+	X(E0, info.link.E0) X(E1, info.link.E1)	\
+	X(M0, info.link.M0) X(M1, info.link.M1)	\
+	X(dt, info.link.dt)	\
+	X(e , info.link.e )	\
+	X(p , info.link.p )	\
+	X(a , info.link.a )	\
+	X(w , info.link.w )	\
+	X(bf, info.link.bf)	\
+/**/
+
+
+namespace utiles
+{
+	// FlightColumns describes a columnar binary flight db (*.fdb)
+	// \note: layout (native byte order):
+	//        - Header
+	//        - Column[chainColumnsCount + infoColumnsCount] - named column directory
+	//        - blocks of columns and the chain index aligned to alignment bytes:
+	//          chain columns - chainsCount FReals, info columns - infosCount FReals,
+	//          index - (chainsCount + 1) UInt64 offsets of chains' first infos
+	// \note: readers look columns up by name, so columns can be added without breaking old files
+	// \note: optional columns can be missed in files written before they were added
+	struct FlightColumns
+	{
+		static constexpr UInt32 version = 1;
+		static constexpr UInt64 alignment = 64;
+
+		struct Header
+		{
+			char   magic[8];
+			UInt32 version;
+			UInt32 realSize;
+			UInt64 chainsCount;
+			UInt64 infosCount;
+			UInt32 chainColumnsCount;
+			UInt32 infoColumnsCount;
+			UInt64 indexOffset;
+		};
+
+		struct Column
+		{
+			char   name[32];
+			UInt64 offset;
+		};
+
+#define FLIGHT_DB_CHAIN_ENUM(name, field) eChain_##name,
+#define FLIGHT_DB_INFO_ENUM(name, field)  eInfo_##name,
+		enum EChainColumn { FLIGHT_DB_CHAIN_COLUMNS(FLIGHT_DB_CHAIN_ENUM) eChainColumnsCount };
+		enum EInfoColumn  { FLIGHT_DB_INFO_COLUMNS (FLIGHT_DB_INFO_ENUM ) eInfoColumnsCount  };
+#undef FLIGHT_DB_CHAIN_ENUM
+#undef FLIGHT_DB_INFO_ENUM
+
+		static bool IsFDB(const std::string& path);
+
+		static bool IsOptional(EChainColumn column);
+	};
+
+	// FlightColumnsWriter collects rows into columns and writes them on Close()
+	// \note: the columns take ~8 bytes per field, that is an order less than the rows' JSON
+	class FlightColumnsWriter final : boost::noncopyable
+	{
+	public:
+		FlightColumnsWriter(const std::string& path);
+
+		void Write(const FlightDB::FlightRow& row);
+		void Close();
+
+		size_t GetCount() const;
+
+	private:
+		std::string path;
+		std::array<std::vector<FReal>, FlightColumns::eChainColumnsCount> chainColumns;
+		std::array<std::vector<FReal>, FlightColumns::eInfoColumnsCount > infoColumns;
+		std::vector<UInt64> index = { 0 };
+		bool bClosed = false;
+	};
+
+	// FlightColumnsReader maps a columnar flight db into memory
+	// \note: columns are read in place; only requested chains are materialised
+	class FlightColumnsReader final : boost::noncopyable
+	{
+	public:
+		FlightColumnsReader(const std::string& path);
+		~FlightColumnsReader();
+
+		size_t GetChainsCount() const;
+		size_t GetInfosCount () const;
+
+		// \note: returns nullptr for a missed optional column
+		const FReal* GetColumn(FlightColumns::EChainColumn column) const;
+		const FReal* GetColumn(FlightColumns::EInfoColumn  column) const;
+
+		// returns a range [begin, end) of the chain's infos in info columns
+		auto GetInfos(size_t chain) const->std::tuple<size_t, size_t>;
+
+		auto GetChain(size_t chain) const->FlightDB::FlightRow;
+
+	private:
+		struct Mapping;
+
+		std::string path;
+		std::unique_ptr<Mapping> mapping;
+		const FlightColumns::Header* header = nullptr;
+		const UInt64* index = nullptr;
+		std::array<const FReal*, FlightColumns::eChainColumnsCount> chainColumns{};
+		std::array<const FReal*, FlightColumns::eInfoColumnsCount > infoColumns{};
+	};
+}
+
+
+#endif //!MAIN__FLIGHTCOLUMNS_HPP
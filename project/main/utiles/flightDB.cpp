@@ -0,0 +1,153 @@
+#include "flightDB.hpp"
+#include "flightColumns.hpp"
+#include <filesystem>
+#include <algorithm>
+
+
+
+namespace utiles
+{
+	bool IsNDJSON(const std::string& path)
+	{
+		return std::filesystem::path(path).extension() == ".ndjson";
+	}
+
+
+	FlightWriter::FlightWriter(const std::string& path)
+		: path(path)
+	{
+		if (FlightColumns::IsFDB(path))
+		{
+			columns = std::make_unique<FlightColumnsWriter>(path);
+			return;
+		}
+
+		os.open(path, std::ios::trunc);
+		if (!os)
+		{
+			throw std::runtime_error("Cannot open flight db on write: '" + path + "'");
+		}
+	}
+
+	FlightWriter::~FlightWriter()
+	{
+		if (os.is_open())
+		{
+			os.close();
+		}
+	}
+
+	void FlightWriter::Write(const FlightDB::FlightRow& row)
+	{
+		if (columns)
+		{
+			columns->Write(row);
+			++count;
+			return;
+		}
+
+		auto ar = reflect::Archiver();
+		row.Marshal(ar);
+		
+		// \note: raw line breaks can be only between JSON tokens, so dropping them keeps the row valid
+		auto data = ar.Save();
+		data.erase(std::remove_if(data.begin(), data.end(), [](char c)
+		{
+			return c == '\n' || c == '\r';
+		}), data.end());
+		
+		os << data << '\n';
+		++count;
+	}
+
+	void FlightWriter::Close()
+	{
+		if (columns)
+		{
+			columns->Close();
+			return;
+		}
+
+		os.close();
+		if (!os)
+		{
+			throw std::runtime_error("Cannot save flight db to destination file: '" + path + "'");
+		}
+	}
+
+	size_t FlightWriter::GetCount() const
+	{
+		return count;
+	}
+
+
+	FlightReader::FlightReader(const std::string& path)
+		: path(path)
+		, bLegacy(!IsNDJSON(path) && !FlightColumns::IsFDB(path))
+	{
+		if (FlightColumns::IsFDB(path))
+		{
+			columns = std::make_unique<FlightColumnsReader>(path);
+			return;
+		}
+		if (bLegacy)
+		{
+			if (!legacy.LoadConfig(path))
+			{
+				throw std::runtime_error("Cannot parse flight db: '" + path + "'");
+			}
+			return;
+		}
+
+		is.open(path);
+		if (!is)
+		{
+			throw std::runtime_error("Cannot open flight db: '" + path + "'");
+		}
+	}
+
+	FlightReader::~FlightReader() = default;
+
+	bool FlightReader::Next(FlightDB::FlightRow& row)
+	{
+		if (columns)
+		{
+			if (next >= columns->GetChainsCount())
+			{
+				return false;
+			}
+			row = columns->GetChain(next++);
+			return true;
+		}
+		if (bLegacy)
+		{
+			if (next >= legacy.flights.size())
+			{
+				return false;
+			}
+			row = std::move(legacy.flights[next++]);
+			return true;
+		}
+
+		auto line = std::string();
+		while (std::getline(is, line))
+		{
+			// \note: getline hits the end of the file only on a line without its line break
+			if (is.eof() || line.find_first_not_of(" \t\r") == std::string::npos)
+			{
+				continue;
+			}
+
+			auto ar = reflect::Archiver();
+			if (!ar.Load(line))
+			{
+				throw std::runtime_error("Cannot parse flight db row " + std::to_string(next) + ": '" + path + "'");
+			}
+			row = FlightDB::FlightRow();
+			row.Unmarshal(ar);
+			++next;
+			return true;
+		}
+		return false;
+	}
+}
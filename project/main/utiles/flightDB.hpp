@@ -0,0 +1,112 @@
+#ifndef MAIN__FLIGHTDB_HPP
+#define MAIN__FLIGHTDB_HPP
+
+#include <boost/noncopyable.hpp>
+#include "pathfinder.hpp"
+#include "reflect/config.hpp"
+#include <fstream>
+
+
+
+struct FlightDB : public reflect::FConfig
+{
+	ARCH_BEGIN(reflect::FConfig)
+		ARCH_FIELD(, , flights)
+		ARCH_END();
+public:
+
+	struct FlightRow : public Pathfinder::PathFinder::FlightRecord
+	{
+		using Super = Pathfinder::PathFinder::FlightRecord;
+
+		ARCH_BEGIN(Super)
+			ARCH_FIELD(, , functionality)
+			ARCH_END();
+	public:
+
+		FlightRow() = default;
+
+		FlightRow(const Super& rhs, FReal functionality = 0)
+			: Super(rhs)
+			, functionality(functionality)
+		{}
+
+		// \note: the chain's links are copied to the row
+		FlightRow(const Pathfinder::PathFinder::FlightChain& rhs, FReal functionality = 0)
+			: Super(rhs)
+			, functionality(functionality)
+		{}
+
+		FReal functionality = 0;
+	};
+
+public:
+
+	std::vector<FlightRow> flights;
+
+public:
+
+	void Save(const std::string& path)
+	{
+		if (!SaveConfig(path))
+		{
+			throw std::runtime_error("Cannot save floght db to destination file: '" + path + "'");
+		}
+	}
+};
+
+
+namespace utiles
+{
+	class FlightColumnsWriter;
+	class FlightColumnsReader;
+
+	// FlightWriter streams flight rows to a NDJSON file: one compact JSON row per line
+	// \note: rows are written as they come, so no copy of the whole DB is kept in memory
+	// \note: *.fdb files are written in the columnar binary format (see FlightColumns)
+	class FlightWriter final : boost::noncopyable
+	{
+	public:
+		FlightWriter(const std::string& path);
+		~FlightWriter();
+
+		void Write(const FlightDB::FlightRow& row);
+
+		// flushes the file and checks that all the rows were written
+		void Close();
+
+		size_t GetCount() const;
+
+	private:
+		std::string path;
+		std::ofstream os;
+		std::unique_ptr<FlightColumnsWriter> columns;
+		size_t count = 0;
+	};
+
+	// FlightReader reads flight rows one by one
+	// \note: *.ndjson files are read line by line, *.fdb files are mapped; other files are loaded as a whole FlightDB
+	class FlightReader final : boost::noncopyable
+	{
+	public:
+		FlightReader(const std::string& path);
+		~FlightReader();
+
+		// reads the next row; returns false at the end of the file
+		// \note: an unterminated last line is the one a killed writer didn't finish, so it's ignored
+		bool Next(FlightDB::FlightRow& row);
+
+	private:
+		std::string path;
+		std::ifstream is;
+		bool bLegacy = false;
+		FlightDB legacy;
+		std::unique_ptr<FlightColumnsReader> columns;
+		size_t next = 0;
+	};
+
+	bool IsNDJSON(const std::string& path);
+}
+
+
+#endif //!MAIN__FLIGHTDB_HPP
@@ -1,6 +1,10 @@
 #include "blocks/link.hpp"
+#include "blocks/rootWindow.hpp"
 #include "trajectory/keplerOrbit.hpp"
+#include "trajectory/lambert.hpp"
 #include "defer.hpp"
+#include "parallel.hpp"
+#include "metrics.hpp"
 
 #include <gsl/gsl_errno.h>
 #include <gsl/gsl_multimin.h>
@@ -175,6 +179,22 @@ namespace Pathfinder::Link::Utiles
 		return false;
 	}
 
+	void LinkAdapter::Assign(const Kepler::Elliptic::Batch& batch, size_t lane)
+	{
+		e  = batch.e [lane];
+		p  = batch.p [lane];
+		w  = batch.w [lane];
+		q0 = batch.q0[lane];
+		q1 = batch.q1[lane];
+		a  = batch.a [lane];
+		E0 = batch.E0[lane];
+		E1 = batch.E1[lane];
+		M0 = batch.M0[lane];
+		M1 = batch.M1[lane];
+		dt = batch.dt[lane];
+		t1 = t0 + dt;
+	}
+
 
 	ScriptedLink::ScriptedLink(const ScriptedLinkConfig& conf, FReal f0_)
 		: LinkAdapter(conf.GM)
@@ -229,165 +249,190 @@ namespace Pathfinder::Link::Utiles
 
 namespace Pathfinder::Link::Utiles
 {
-	class RootWindowHelper final
+	// (t_expected - t_required) function of a link counting its evaluations
+	// \note: the link is left solved for the last evaluated time
+	struct Mismatch
 	{
-	public:
-		enum EState
-		{
-			  ePositive = 1 << 0
-			, eNegative = 1 << 1
-			, eZero		= 1 << 2
-			, eNAN		= 1 << 3
-		};
-
-		enum class EPatternType
-		{
-			  eNone
-			, eRoot
-			, eSign
-			, eExtr
-		};
+		ScriptedLink& link;
+		Int32 evaluations = 0;
+		FReal closest = INFINITY; // the least |delta| evaluated
 
-		struct Point
+		bool operator()(FReal t, FReal& delta)
 		{
-			EState state = EState::eNAN;
-			FReal  delta = 0;
-			FReal  time = 0;
-		};
-
-	private:
-		std::array<Point, 3> window;
-		FReal DTOL;
-
-	public:
-		RootWindowHelper(FReal DTOL = Math::Epsilon)
-			: DTOL(DTOL)
-		{}
-
-		void Push(FReal time, FReal delta)
-		{
-			window[2] = window[1];
-			window[1] = window[0];
-			window[0].state = DeduceState(delta);
-			window[0].delta = delta;
-			window[0].time = time;
-		}
-
-		EState DeduceState(FReal delta)
-		{
-			return isnan(delta)               ? EState::eNAN 
-				: Math::Equal(delta, 0, DTOL) ? EState::eZero
-				: delta > 0                   ? EState::ePositive : EState::eNegative
-				;
+			++evaluations;
+			if (!link.Find_t(t))
+			{
+				return false;
+			}
+			delta = t - link.t1;
+			closest = Math::Min(closest, Math::Abs(delta));
+			return true;
 		}
+	};
 
-		auto GetRoot()->std::tuple<Point, Point, EPatternType>
+	bool FindAsRoot(Mismatch& F, FReal t0, FReal t1, FReal v0, FReal v1, FReal DTOL, FReal TTOL)
+	{
+		using namespace Math;
+		do
 		{
-			auto pattern = GetPattern();
-			switch (pattern)
+			auto tm = (t0 + t1) / 2;
+			auto vm = FReal(0);
+			if (!F(tm, vm))
 			{
-			case EPatternType::eRoot: {
-				auto p = window[0];
-				return { p, p, pattern };
+				return false;
 			}
-			case EPatternType::eSign: {
-				auto p0 = window[0];
-				auto p1 = window[1];
-				return { p1, p0, pattern };
+
+			if (Equal(vm, 0, DTOL))
+			{
+				return true;
 			}
-			case EPatternType::eExtr: {
-				auto p0 = window[0];
-				auto p1 = window[2];
-				return { p1, p0, pattern };
+			
+			if (Sign(v0) == Sign(vm))
+			{ 
+				t0 = tm; v0 = vm; 
 			}
-			case EPatternType::eNone:
-				return { {}, {}, pattern };
+			else 
+			{ 
+				t1 = tm; v1 = vm; 
 			}
-			throw std::runtime_error("unexpected pattern type: (" + std::to_string((int)pattern) + ")");
-		}
+		} while (Abs(t1 - t0) > TTOL);
 
-		bool CheckRoot()
-		{
-			return GetPattern() != EPatternType::eNone;
-		}
+		return false;
+	}
 
-		EPatternType GetPattern()
+	// false position with Illinois' modification: the value of an end kept twice is halved
+	bool FindAsRoot_Illinois(Mismatch& F, FReal t0, FReal t1, FReal v0, FReal v1, FReal DTOL, FReal TTOL)
+	{
+		using namespace Math;
+		auto side = 0;
+		for (auto iter = 0; iter < 100 && Abs(t1 - t0) > TTOL; ++iter)
 		{
-			auto s0 = window[0].state;
-			auto s1 = window[1].state;
-			auto s2 = window[2].state;
-			if (s0 == EState::eZero)
+			auto tm = (t0 * v1 - t1 * v0) / (v1 - v0);
+			auto vm = FReal(0);
+			if (!F(tm, vm))
 			{
-				return EPatternType::eRoot;
+				return false;
 			}
-			if ((s0 | s1) == (EState::eNegative | EState::ePositive))
+
+			if (Equal(vm, 0, DTOL))
 			{
-				return EPatternType::eSign;
+				return true;
 			}
-			if ((s0 & s1 & s2) & (EState::eNegative | EState::ePositive)) 
+
+			if (Sign(vm) == Sign(v1))
 			{
-				using namespace Math;
-				const auto v3 = Abs(window[0].delta); // n
-				const auto v2 = Abs(window[1].delta); // n - 1
-				const auto v1 = Abs(window[2].delta); // n - 2
-				const auto d12 = v2 - v1;
-				const auto d13 = v3 - v1;
-				if (Equal(d13, 0) && d12 < 0)
+				t1 = tm; v1 = vm;
+				if (side == -1)
 				{
-					return EPatternType::eExtr;
+					v0 /= 2;
 				}
-				if (d13 > 0 && d12 < d13 / 4)
+				side = -1;
+			}
+			else
+			{
+				t0 = tm; v0 = vm;
+				if (side == +1)
 				{
-					return EPatternType::eExtr;
+					v1 /= 2;
 				}
+				side = +1;
 			}
-			return EPatternType::eNone;
 		}
-	};
-}
-
+		return false;
+	}
 
-namespace Pathfinder::Link::Utiles
-{
-	bool FindAsRoot(ScriptedLink& link, FReal t0, FReal t1, FReal v0, FReal v1, FReal DTOL, FReal TTOL)
+	// Brent's method: inverse quadratic interpolation and secant steps guarded by bisection
+	bool FindAsRoot_Brent(Mismatch& F, FReal t0, FReal t1, FReal v0, FReal v1, FReal DTOL, FReal TTOL)
 	{
 		using namespace Math;
-		do
+		auto a = t0, fa = v0;
+		auto b = t1, fb = v1;
+		auto c = b , fc = fb;
+		auto d = b - a;
+		auto e = d;
+		for (auto iter = 0; iter < 100; ++iter)
 		{
-			auto tm = (t0 + t1) / 2;
-			if (!link.Find_t(tm))
+			if (Sign(fb) == Sign(fc))
+			{ // c is the opposite end of the bracket
+				c = a; fc = fa;
+				e = d = b - a;
+			}
+			if (Abs(fc) < Abs(fb))
+			{ // b is the best estimation
+				a = b; b = c; c = a;
+				fa = fb; fb = fc; fc = fa;
+			}
+
+			auto tol = TTOL / 2;
+			auto xm  = (c - b) / 2;
+			if (Abs(xm) <= tol)
 			{
 				return false;
 			}
 
-			auto vm = tm - link.t1;
-			if (Equal(vm, 0, DTOL))
+			if (Abs(e) >= tol && Abs(fa) > Abs(fb))
+			{ // try an interpolation
+				auto p = FReal(0);
+				auto q = FReal(0);
+				auto s = fb / fa;
+				if (a == c)
+				{ // secant
+					p = 2 * xm * s;
+					q = 1 - s;
+				}
+				else
+				{ // inverse quadratic
+					auto r = fb / fc;
+					q = fa / fc;
+					p = s * (2 * xm * q * (q - r) - (b - a) * (r - 1));
+					q = (q - 1) * (r - 1) * (s - 1);
+				}
+				if (p > 0)
+				{
+					q = -q;
+				}
+				p = Abs(p);
+
+				if (2 * p < Min(3 * xm * q - Abs(tol * q), Abs(e * q)))
+				{
+					e = d;
+					d = p / q;
+				}
+				else
+				{
+					d = xm;
+					e = d;
+				}
+			}
+			else
 			{
-				return true;
+				d = xm;
+				e = d;
 			}
-			
-			if (Sign(v0) == Sign(vm))
-			{ 
-				t0 = tm; v0 = vm; 
+
+			a = b; fa = fb;
+			b += Abs(d) > tol ? d : tol * Sign(xm);
+			if (!F(b, fb))
+			{
+				return false;
 			}
-			else 
-			{ 
-				t1 = tm; v1 = vm; 
+			if (Equal(fb, 0, DTOL))
+			{
+				return true;
 			}
-		} while (Abs(t1 - t0) > TTOL);
-
+		}
 		return false;
 	}
 
-	bool FindMinimum(ScriptedLink& link, FReal t0, FReal t1, FReal v0, FReal v1, FReal DTOL, FReal TTOL)
+	bool FindMinimum(Mismatch& M, FReal t0, FReal t1, FReal v0, FReal v1, FReal DTOL, FReal TTOL)
 	{
 		struct Params
 		{
-			ScriptedLink& link; 
+			Mismatch& M; 
 			FReal t0;
 			FReal t1;
 		};
-		auto params = Params{ link, t0, t1 };
+		auto params = Params{ M, t0, t1 };
 
 		// mirror the problem to positive space
 		v0 = Math::Abs(v0);
@@ -407,11 +452,12 @@ namespace Pathfinder::Link::Utiles
 				return NAN;
 			}
 
-			if (!p->link.Find_t(t))
+			auto delta = FReal(0);
+			if (!p->M(t, delta))
 			{ 
 				return NAN; 
 			}
-			return Math::Abs(t - p->link.t1);
+			return Math::Abs(delta);
 		};
 
 		// initial point and stepsize
@@ -469,18 +515,276 @@ namespace Pathfinder::Link::Utiles
 		}
 		return false;
 	}
+
+	// Brent's minimisation of |t_expected - t_required| from the lowest point x of the pattern
+	// \note: parabolic steps guarded by golden sections; stops as soon as the mismatch is tolerable
+	bool FindMinimum_Brent(Mismatch& M, FReal t0, FReal t1, FReal x, FReal fx, FReal DTOL, FReal TTOL)
+	{
+		using namespace Math;
+		constexpr auto golden = 0.3819660112501051;
+
+		auto a = t0;
+		auto b = t1;
+		auto w = x, fw = Abs(fx);
+		auto v = x, fv = Abs(fx);
+		fx = Abs(fx);
+		auto d = FReal(0);
+		auto e = FReal(0);
+		for (auto iter = 0; iter < 100; ++iter)
+		{
+			auto tol = TTOL / 2;
+			auto xm  = (a + b) / 2;
+			if (Abs(x - xm) <= 2 * tol - (b - a) / 2)
+			{
+				return false;
+			}
+
+			auto bGolden = true;
+			if (Abs(e) > tol)
+			{ // try a parabola through x, w, v
+				auto r = (x - w) * (fx - fv);
+				auto q = (x - v) * (fx - fw);
+				auto p = (x - v) * q - (x - w) * r;
+				q = 2 * (q - r);
+				if (q > 0)
+				{
+					p = -p;
+				}
+				q = Abs(q);
+				if (Abs(p) < Abs(q * e / 2) && p > q * (a - x) && p < q * (b - x))
+				{
+					e = d;
+					d = p / q;
+					auto u = x + d;
+					if (u - a < 2 * tol || b - u < 2 * tol)
+					{
+						d = tol * (xm - x >= 0 ? 1 : -1);
+					}
+					bGolden = false;
+				}
+			}
+			if (bGolden)
+			{
+				e = x >= xm ? a - x : b - x;
+				d = golden * e;
+			}
+
+			auto u  = Abs(d) >= tol ? x + d : x + tol * (d >= 0 ? 1 : -1);
+			auto fu = FReal(0);
+			if (!M(u, fu))
+			{
+				return false;
+			}
+			fu = Abs(fu);
+			if (fu <= DTOL)
+			{
+				return true;
+			}
+
+			if (fu <= fx)
+			{
+				(u >= x ? a : b) = x;
+				v = w; fv = fw;
+				w = x; fw = fx;
+				x = u; fx = fu;
+			}
+			else
+			{
+				(u < x ? a : b) = u;
+				if (fu <= fw || w == x)
+				{
+					v = w; fv = fw;
+					w = u; fw = fu;
+				}
+				else if (fu <= fv || v == x || v == w)
+				{
+					v = u; fv = fu;
+				}
+			}
+		}
+		return false;
+	}
 }
 
 
 namespace Pathfinder::Link
 {
-	void FindLinks(std::vector<Link>& links, const StaticLinkConfig& cfg, const std::vector<FReal>& f0s)
+	namespace
 	{
-		for (auto f0 : f0s)
+		const auto rootEvaluations    = Metrics::Histogram("FindAsRoot.evaluations");
+		const auto minimumEvaluations = Metrics::Histogram("FindMinimum.evaluations");
+		const auto missedRoots        = Metrics::Counter  ("FindAsRoot.count_of_missed_roots");
+		const auto missedRoot         = Metrics::Histogram("FindAsRoot.missed_root"); // the least |t_expected - t_required| of a missed root [s] (if any was solved)
+
+		// refines a root of (t_expected - t_required) function the window has found
+		// \note: the link must be solved for the window's last time
+		bool RefineRoot(Utiles::ScriptedLink& link, Utiles::RootWindowHelper& window, const ScriptedLinkConfig& cfg)
+		{
+			using EPatternType = Utiles::RootWindowHelper::EPatternType;
+			auto [p0, p1, mode] = window.GetRoot();
+			if (mode == EPatternType::eRoot)
+			{
+				return true;
+			}
+
+			auto F   = Utiles::Mismatch{ link };
+			auto bOK = false;
+			if (mode == EPatternType::eSign)
+			{
+				switch (cfg.polisher)
+				{
+				case ERootPolisher::eBisection: bOK = Utiles::FindAsRoot         (F, p0.time, p1.time, p0.delta, p1.delta, cfg.tt, cfg.td); break;
+				case ERootPolisher::eIllinois : bOK = Utiles::FindAsRoot_Illinois(F, p0.time, p1.time, p0.delta, p1.delta, cfg.tt, cfg.td); break;
+				case ERootPolisher::eBrent    : bOK = Utiles::FindAsRoot_Brent   (F, p0.time, p1.time, p0.delta, p1.delta, cfg.tt, cfg.td); break;
+				default:
+					throw std::runtime_error("unexpected polisher: " + std::to_string((int)cfg.polisher));
+				}
+			}
+			else if (mode == EPatternType::eExtr)
+			{
+				auto& pm = window.GetMiddle();
+				bOK = cfg.polisher == ERootPolisher::eBisection
+					? Utiles::FindMinimum      (F, p0.time, p1.time, p0.delta, p1.delta, cfg.tt, cfg.td)
+					: Utiles::FindMinimum_Brent(F, p0.time, p1.time, pm.time, pm.delta, cfg.tt, cfg.td)
+					;
+			}
+			else throw std::runtime_error("unexpected mode: " + std::to_string((int)mode));
+
+			(mode == EPatternType::eSign ? rootEvaluations : minimumEvaluations).Observe(F.evaluations);
+			if (!bOK)
+			{
+				missedRoots.Add();
+				if (!isinf(F.closest))
+				{
+					missedRoot.Observe(F.closest);
+				}
+			}
+			if (cfg.counters)
+			{
+				cfg.counters->calls += 1;
+				cfg.counters->evaluations += F.evaluations;
+				cfg.counters->found += bOK;
+			}
+			return bOK;
+		}
+
+		// scans all the toss angles together: B's location is found once per step, and the transfers are solved
+		// with the batch kernel; roots are refined one by one, so the links are the same as the scalar scan finds
+		void FindLinks(std::vector<Link>& links, const ScriptedLinkConfig& cfg, const FReal* f0s, size_t count)
 		{
-			auto link = Utiles::StaticLink(cfg, f0);
-			if (link.Find_t())
+			auto lanes   = std::vector<Utiles::ScriptedLink>();
+			auto windows = std::vector<Utiles::RootWindowHelper>(count, Utiles::RootWindowHelper(cfg.ts / 10));
+			auto found   = std::vector<std::vector<Link>>(count);
+			auto batch   = Kepler::Elliptic::Batch();
+			lanes.reserve(count);
+			batch.Resize(count);
+			for (size_t i = 0; i < count; ++i)
 			{
+				auto& lane = lanes.emplace_back(cfg, f0s[i]);
+				batch.f0[i] = lane.f0;
+			}
+			if (!count)
+			{
+				return;
+			}
+
+			auto& proto = lanes.front();
+			auto  B     = cfg.B;
+			for (auto t_exp = cfg.t0; t_exp < cfg.te; t_exp += cfg.ts)
+			{
+				B.SetTime(t_exp);
+				auto R1 = B.GetLocation();
+				auto Q1 = proto.Q0 + Math::Angle2(proto.R0, R1, Math::EPosAngles());
+				Kepler::Elliptic::Solve(batch, proto.r0, R1.Size(), proto.Q0, Q1, cfg.GM);
+
+				for (size_t i = 0; i < count; ++i)
+				{
+					if (!batch.valid[i])
+					{
+						windows[i].Push(t_exp, NAN);
+						continue;
+					}
+
+					windows[i].Push(t_exp, t_exp - (cfg.t0 + batch.dt[i]));
+					if (!windows[i].CheckRoot())
+					{
+						continue;
+					}
+
+					// \note: the lane's link is solved for the time as the scalar scan leaves it
+					auto& link = lanes[i];
+					if (link.Find_t(t_exp) && RefineRoot(link, windows[i], cfg) && link.FixParams())
+					{
+						found[i].push_back(link);
+					}
+				}
+			}
+
+			for (auto& lane : found)
+			{
+				links.insert(links.end(), std::make_move_iterator(lane.begin()), std::make_move_iterator(lane.end()));
+			}
+		}
+
+		// runs FindRange(links, bgn, end) over [0, count) split on contiguous blocks (a few per worker to balance the load)
+		// \note: the blocks are merged in order, so the result matches the sequential one
+		template<typename FindRangeFn>
+		void FindInBlocks(std::vector<Link>& links, size_t count, Int32 threads, FindRangeFn&& FindRange)
+		{
+			if (threads == 1 || count < 2)
+			{
+				FindRange(links, 0, count);
+				return;
+			}
+
+			auto workers = Parallel::GetWorkersCount(threads);
+			auto blocks  = std::vector<std::vector<Link>>(std::min(count, workers * 4));
+			Parallel::For(blocks.size(), workers, [&](size_t i)
+			{
+				auto bgn = count * (i + 0) / blocks.size();
+				auto end = count * (i + 1) / blocks.size();
+				FindRange(blocks[i], bgn, end);
+			});
+
+			for (auto& block : blocks)
+			{
+				links.insert(links.end(), std::make_move_iterator(block.begin()), std::make_move_iterator(block.end()));
+			}
+		}
+	}
+
+	void FindLinks(std::vector<Link>& links, const StaticLinkConfig& cfg, const std::vector<FReal>& f0s, EKernel kernel)
+	{
+		if (kernel == EKernel::eScalar)
+		{
+			for (auto f0 : f0s)
+			{
+				auto link = Utiles::StaticLink(cfg, f0);
+				if (link.Find_t())
+				{
+					link.FixParams();
+					links.push_back(std::move(link));
+				}
+			}
+			return;
+		}
+
+		// the end points are the same for all the toss angles
+		auto proto = Utiles::StaticLink(cfg, 0);
+		auto batch = Kepler::Elliptic::Batch();
+		batch.Resize(f0s.size());
+		for (size_t i = 0; i < f0s.size(); ++i)
+		{
+			batch.f0[i] = Kepler::Elliptic::NZ(f0s[i]);
+		}
+		Kepler::Elliptic::Solve(batch, proto.r0, proto.r1, proto.Q0, proto.Q1, cfg.GM);
+
+		for (size_t i = 0; i < f0s.size(); ++i)
+		{
+			if (batch.valid[i])
+			{
+				auto link = Utiles::StaticLink(cfg, f0s[i]);
+				link.Assign(batch, i);
 				link.FixParams();
 				links.push_back(std::move(link));
 			}
@@ -507,39 +811,85 @@ namespace Pathfinder::Link
 				continue;
 			}
 
-			auto [p0, p1, mode] = window.GetRoot();
-			switch (mode) 
+			if (RefineRoot(link, window, cfg) && link.FixParams())
 			{
-			case Utiles::RootWindowHelper::EPatternType::eRoot: break;
-			case Utiles::RootWindowHelper::EPatternType::eSign:
-				if (!Utiles::FindAsRoot(link, p0.time, p1.time, p0.delta, p1.delta, cfg.tt, cfg.td))
-				{
-					continue;
-				} 
-				else break;
+				links.push_back(link);
+			}
+		}
+	}
 
-			case Utiles::RootWindowHelper::EPatternType::eExtr:
-				if (!Utiles::FindMinimum(link, p0.time, p1.time, p0.delta, p1.delta, cfg.tt, cfg.td))
-				{
-					continue;
-				}
-				else break;
+	void FindLinks(std::vector<Link>& links, const ScriptedLinkConfig& cfg, const std::vector<FReal>& f0s, EKernel kernel)
+	{
+		// finds links of toss angles [bgn, end) with the selected kernel
+		// \note: a single toss angle gains nothing from the batch, so it's scanned without the batch's buffers
+		FindInBlocks(links, f0s.size(), cfg.threads, [&cfg, &f0s, kernel](std::vector<Link>& links, size_t bgn, size_t end)
+		{
+			if (kernel == EKernel::eBatch && end - bgn > 1)
+			{
+				FindLinks(links, cfg, f0s.data() + bgn, end - bgn);
+				return;
+			}
+			for (auto i = bgn; i < end; ++i)
+			{
+				FindLinks(links, cfg, f0s[i]);
+			}
+		});
+	}
 
-			default: throw std::runtime_error("unexpected mode: " + std::to_string((int)mode));
+	// solves the links of both directions of motion arriving to B at t1
+	void FindLambertLinks(std::vector<Link>& links, const ScriptedLinkConfig& cfg, FReal t1)
+	{
+		if (!(t1 > cfg.t0))
+		{
+			return;
+		}
+
+		// the plane's basis of the links to the arrival point
+		auto B = cfg.B;
+		B.SetTime(t1);
+		auto plane = Link();
+		plane.R0 = cfg.RA;
+		plane.R1 = B.GetLocation();
+		plane.Q1 = plane.Q0 + Math::Angle2(plane.R0, plane.R1, Math::EPosAngles());
+		auto X = plane.GetAxisX();
+		auto Y = plane.GetAxisY();
+
+		for (auto bPrograde : { true, false })
+		{
+			auto [VV, bOK] = Kepler::Lambert::VV(plane.R0, plane.R1, t1 - cfg.t0, cfg.GM, bPrograde);
+			if (!bOK)
+			{
+				continue;
 			}
 
-			if (link.FixParams())
+			// \note: the transfer through both the points with the departure velocity's orientation is
+			//        the Lambert's one, so the link's elements and flight time are solved as usual
+			auto link = Utiles::ScriptedLink(cfg, Math::Atan2(VV.V0 | Y, VV.V0 | X));
+			if (link.Find_t(t1) && Math::Abs(link.t1 - t1) <= cfg.tt && link.FixParams())
 			{
 				links.push_back(link);
 			}
 		}
 	}
 
-	void FindLinks(std::vector<Link>& links, const ScriptedLinkConfig& cfg, const std::vector<FReal>& f0s)
+	void FindLambertLinks(std::vector<Link>& links, const ScriptedLinkConfig& cfg, const std::vector<FReal>& t1s)
+	{
+		FindInBlocks(links, t1s.size(), cfg.threads, [&cfg, &t1s](std::vector<Link>& links, size_t bgn, size_t end)
+		{
+			for (auto i = bgn; i < end; ++i)
+			{
+				FindLambertLinks(links, cfg, t1s[i]);
+			}
+		});
+	}
+
+	void FindLambertLinks(std::vector<Link>& links, const ScriptedLinkConfig& cfg)
 	{
-		for (auto f0 : f0s)
+		auto t1s = std::vector<FReal>();
+		for (auto t1 = cfg.t0 + cfg.ts; t1 < cfg.te; t1 += cfg.ts)
 		{
-			FindLinks(links, cfg, f0);
+			t1s.push_back(t1);
 		}
+		FindLambertLinks(links, cfg, t1s);
 	}
 }
@@ -2,12 +2,23 @@
 #define PATHFINDER__LINK_HPP
 
 #include "links.hpp"
+#include "mission.hpp"
 #include "trajectory/ephemeridesClient.hpp"
+#include "trajectory/keplerOrbit.hpp"
+#include <atomic>
 
 
 
 namespace Pathfinder::Link
 {
+	// counters of the root polishing calls (shared by the workers of a scan)
+	struct PolishCounters
+	{
+		std::atomic<UInt64> calls       { 0 }; // polished sign changes and extrema
+		std::atomic<UInt64> evaluations { 0 }; // transfers solved by the polishing
+		std::atomic<UInt64> found       { 0 }; // polishings found a root
+	};
+
 	struct ScriptedLinkConfig
 	{
 		FVector RA;
@@ -19,6 +30,9 @@ namespace Pathfinder::Link
 		FReal tt = NAN; // [s] - mismatch tolerance
 		FReal td = NAN; // [s] - 
 		FReal GM = NAN; // [m3/s2]
+		Int32 threads = 1; // max count of workers to scan toss angles with (0 - one per hardware thread)
+		ERootPolisher polisher = ERootPolisher::eBisection;
+		PolishCounters* counters = nullptr; // optional
 
 		void SetA(Ephemerides::IEphemerides& script);
 		void SetB(Ephemerides::IEphemerides& script);
@@ -53,6 +67,9 @@ namespace Pathfinder::Link::Utiles
 		virtual void FixW01() = 0;
 
 		bool Find_t();
+
+		// takes the transfer of the batch's lane as Find_t() would find it
+		void Assign(const Kepler::Elliptic::Batch& batch, size_t lane);
 	};
 
 	struct ScriptedLink : public LinkAdapter
@@ -81,8 +98,22 @@ namespace Pathfinder::Link::Utiles
 
 namespace Pathfinder::Link
 {
-	void FindLinks(std::vector<Link>& links, const StaticLinkConfig  & cfg, const std::vector<FReal>& f0s);
-	void FindLinks(std::vector<Link>& links, const ScriptedLinkConfig& cfg, const std::vector<FReal>& f0s);
+	// kernels solving transfers of toss angles
+	enum class EKernel
+	{
+		  eScalar // one toss angle at a time (reference)
+		, eBatch  // all the toss angles at once: a scripted B is located once per time step (see Kepler::Elliptic::Solve)
+	};
+
+	void FindLinks(std::vector<Link>& links, const StaticLinkConfig  & cfg, const std::vector<FReal>& f0s, EKernel kernel = EKernel::eBatch);
+	void FindLinks(std::vector<Link>& links, const ScriptedLinkConfig& cfg, const std::vector<FReal>& f0s, EKernel kernel = EKernel::eBatch);
+
+	// solves the links arriving to B at the scan grid's times (t0 + ts, t0 + 2*ts, ... < te) with Lambert's problem
+	// \note: toss angles are taken from the solutions (a prograde and a retrograde one per arrival time),
+	//        so neither toss angles nor a root search are needed
+	void FindLambertLinks(std::vector<Link>& links, const ScriptedLinkConfig& cfg);
+	// the same for explicit arrival times (e.g. a grid of flight times)
+	void FindLambertLinks(std::vector<Link>& links, const ScriptedLinkConfig& cfg, const std::vector<FReal>& t1s);
 }
 
 
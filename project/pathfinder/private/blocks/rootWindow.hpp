@@ -0,0 +1,139 @@
+#ifndef PATHFINDER__ROOTWINDOW_HPP
+#define PATHFINDER__ROOTWINDOW_HPP
+
+#include "math/math.hpp"
+#include <array>
+#include <stdexcept>
+#include <string>
+#include <tuple>
+
+
+
+namespace Pathfinder::Link::Utiles
+{
+	// RootWindowHelper keeps the last 3 points of a scanned mismatch function and recognises roots' patterns in them
+	class RootWindowHelper final
+	{
+	public:
+		enum EState
+		{
+			  ePositive = 1 << 0
+			, eNegative = 1 << 1
+			, eZero		= 1 << 2
+			, eNAN		= 1 << 3
+		};
+
+		enum class EPatternType
+		{
+			  eNone
+			, eRoot
+			, eSign
+			, eExtr
+		};
+
+		struct Point
+		{
+			EState state = EState::eNAN;
+			FReal  delta = 0;
+			FReal  time = 0;
+		};
+
+	private:
+		std::array<Point, 3> window;
+		FReal DTOL;
+
+	public:
+		RootWindowHelper(FReal DTOL = Math::Epsilon)
+			: DTOL(DTOL)
+		{}
+
+		void Push(FReal time, FReal delta)
+		{
+			window[2] = window[1];
+			window[1] = window[0];
+			window[0].state = DeduceState(delta);
+			window[0].delta = delta;
+			window[0].time = time;
+		}
+
+		EState DeduceState(FReal delta)
+		{
+			return isnan(delta)               ? EState::eNAN 
+				: Math::Equal(delta, 0, DTOL) ? EState::eZero
+				: delta > 0                   ? EState::ePositive : EState::eNegative
+				;
+		}
+
+		auto GetRoot()->std::tuple<Point, Point, EPatternType>
+		{
+			auto pattern = GetPattern();
+			switch (pattern)
+			{
+			case EPatternType::eRoot: {
+				auto p = window[0];
+				return { p, p, pattern };
+			}
+			case EPatternType::eSign: {
+				auto p0 = window[0];
+				auto p1 = window[1];
+				return { p1, p0, pattern };
+			}
+			case EPatternType::eExtr: {
+				auto p0 = window[0];
+				auto p1 = window[2];
+				return { p1, p0, pattern };
+			}
+			case EPatternType::eNone:
+				return { {}, {}, pattern };
+			}
+			throw std::runtime_error("unexpected pattern type: (" + std::to_string((int)pattern) + ")");
+		}
+
+		// the lowest point of an extremum's pattern
+		const Point& GetMiddle() const
+		{
+			return window[1];
+		}
+
+		bool CheckRoot()
+		{
+			return GetPattern() != EPatternType::eNone;
+		}
+
+		EPatternType GetPattern()
+		{
+			auto s0 = window[0].state;
+			auto s1 = window[1].state;
+			auto s2 = window[2].state;
+			if (s0 == EState::eZero)
+			{
+				return EPatternType::eRoot;
+			}
+			if ((s0 | s1) == (EState::eNegative | EState::ePositive))
+			{
+				return EPatternType::eSign;
+			}
+			if ((s0 & s1 & s2) & (EState::eNegative | EState::ePositive)) 
+			{
+				using namespace Math;
+				const auto v3 = Abs(window[0].delta); // n
+				const auto v2 = Abs(window[1].delta); // n - 1
+				const auto v1 = Abs(window[2].delta); // n - 2
+				const auto d12 = v2 - v1;
+				const auto d13 = v3 - v1;
+				if (Equal(d13, 0) && d12 < 0)
+				{
+					return EPatternType::eExtr;
+				}
+				if (d13 > 0 && d12 < d13 / 4)
+				{
+					return EPatternType::eExtr;
+				}
+			}
+			return EPatternType::eNone;
+		}
+	};
+}
+
+
+#endif //!PATHFINDER__ROOTWINDOW_HPP
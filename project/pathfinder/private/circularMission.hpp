@@ -0,0 +1,106 @@
+#ifndef PATHFINDER__CIRCULARMISSION_HPP
+#define PATHFINDER__CIRCULARMISSION_HPP
+
+#include "pathfinder.hpp"
+#include "planetScriptSimple.hpp"
+#include "nodes.hpp"
+#include "blocks/link.hpp"
+
+
+
+// bodies with circular orbits and missions between them, so tests and benchmarks run without SPICE kernels
+namespace Pathfinder::Circular
+{
+	using Script = PlanetScript::PlanetScriptSimple;
+
+	inline auto MakeSun()                      { return std::make_shared<Script>(1.327E+20, 0., 0., 0.); }
+	inline auto MakeEarth(FReal phase = 0.)    { return std::make_shared<Script>(3.986E+14, 149.6E+9, 31.6E+6, phase); }
+	inline auto MakeVenus(FReal phase = 2.)    { return std::make_shared<Script>(3.248E+14, 108.2E+9, 19.4E+6, phase); }
+	inline auto MakeMars (FReal phase = 0.776) { return std::make_shared<Script>(4.282E+13, 227.9E+9, 59.4E+6, phase); }
+
+	// Earth -> Mars mission of one launch date
+	inline Mission MakeMission()
+	{
+		auto A = std::make_unique<NodeDeparture::Circular>();
+		auto B = std::make_unique<NodeArrival  ::Circular>();
+		A->ParkingRadius = 6.6e+6;
+		B->ParkingRadius = 3.8e+6;
+		A->SphereRadius = 2.6e+8;
+		B->SphereRadius = 1.3e+8;
+		A->ImpulseLimit = 7000;
+		B->ImpulseLimit = 3000;
+		A->Script = MakeEarth();
+		B->Script = MakeMars();
+
+		auto mission = Mission();
+		mission.GM = MakeSun()->GetGM(0);
+		mission.faxConfig.normalFlyPeriodFactor = 1;
+		mission.faxConfig.points_f0 = 60;
+		mission.faxConfig.timeFrac  = 3600.;
+		mission.faxConfig.timeTol   = 3600. * 24;
+		mission.faxConfig.timeStep  = 3600. * 24 * 15;
+		mission.saxConfig.CopyValus(mission.faxConfig);
+		mission.saxConfig.maxMinimisationIters = 10;
+		mission.saxConfig.burnNodeFactory = []()
+		{
+			return std::make_shared<Nodes::BurnNode>();
+		};
+		mission.t0 = 0;
+		mission.nodes.push_back(std::move(A));
+		mission.nodes.push_back(std::move(B));
+		return mission;
+	}
+
+	// Earth -> Venus -> Mars mission of one launch date with loose limits
+	inline Mission MakeFlybyMission()
+	{
+		auto A = std::make_unique<NodeDeparture::Circular>();
+		auto V = std::make_unique<Nodes::NodeFlyBy>();
+		auto B = std::make_unique<NodeArrival  ::Circular>();
+		A->ParkingRadius = 6.6e+6;
+		B->ParkingRadius = 3.8e+6;
+		A->SphereRadius = 2.6e+8;
+		B->SphereRadius = 1.3e+8;
+		A->ImpulseLimit = 20000;
+		B->ImpulseLimit = 20000;
+		A->Script = MakeEarth();
+		B->Script = MakeMars();
+		V->MismatchLimit = 3e+4;
+		V->SphereRadius = 1.7e+8;
+		V->PlanetRadius = 6e+6;
+		V->Script = MakeVenus();
+
+		auto mission = Mission();
+		mission.GM = MakeSun()->GetGM(0);
+		mission.faxConfig.normalFlyPeriodFactor = 1;
+		mission.faxConfig.points_f0 = 60;
+		mission.faxConfig.timeFrac  = 3600.;
+		mission.faxConfig.timeTol   = 3600. * 24;
+		mission.faxConfig.timeStep  = 3600. * 24 * 15;
+		mission.saxConfig.CopyValus(mission.faxConfig);
+		mission.t0 = 0;
+		mission.nodes.push_back(std::move(A));
+		mission.nodes.push_back(std::move(V));
+		mission.nodes.push_back(std::move(B));
+		return mission;
+	}
+
+	// scan of transfers around the Sun from A to B over B's period
+	// \note: the config keeps a pointer to B, so B must outlive it
+	inline Link::ScriptedLinkConfig MakeScriptedConfig(Script& A, Script& B, FReal tt = 3600. * 24)
+	{
+		auto conf = Link::ScriptedLinkConfig();
+		conf.t0 = 0;
+		conf.SetA(A);
+		conf.SetB(B);
+		conf.te = B.GetT(0);
+		conf.ts = B.GetT(0) / 160;
+		conf.tt = tt;
+		conf.td = tt / 100;
+		conf.GM = MakeSun()->GetGM(0);
+		return conf;
+	}
+}
+
+
+#endif //!PATHFINDER__CIRCULARMISSION_HPP
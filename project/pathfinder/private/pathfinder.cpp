@@ -1,12 +1,74 @@
 #include "solvers/FirstApprox.hpp"
 #include "solvers/SecondApprox.hpp"
+#include "solvers/legCache.hpp"
+#include "solvers/incumbent.hpp"
+#include "solvers/resultsFilter.hpp"
+#include "solvers/seedClusters.hpp"
+#include "solvers/linkPool.hpp"
+#include "parallel.hpp"
+#include "metrics.hpp"
+#include <algorithm>
+#include <mutex>
 
 
 
 namespace Pathfinder
 {
+	namespace
+	{
+		const auto saxTime        = Metrics::Timer    ("SAX.time");
+		const auto saxEvaluations = Metrics::Histogram("SAX.evaluations");
+		const auto saxFailed      = Metrics::Counter  ("SAX.count_of_failed_paths");
+
+		// returns values which tell a FAX flight from the other ones of the sweep
+		auto GetSeedKey(const PathFinder::FlightChain& seed) -> std::vector<FReal>
+		{
+			auto key = std::vector<FReal>{ seed.startTime };
+			for (size_t i = 0; i < seed.chain.size(); ++i)
+			{
+				auto& link = seed.GetLink(i);
+				key.insert(key.end(), { link.t0, link.f0, link.dt });
+			}
+			return key;
+		}
+
+		// LinkMover points flights to the pool, copying each link of their own pools once
+		class LinkMover
+		{
+		public:
+			LinkMover(std::shared_ptr<Solvers::LinkPool> pool)
+				: pool(std::move(pool))
+			{}
+
+			void operator()(PathFinder::FlightChain& flight)
+			{
+				if (!flight.links || flight.links == pool)
+				{
+					return;
+				}
+				auto& remap = remaps[flight.links];
+				remap.resize(flight.links->GetCount(), Solvers::LinkPool::none);
+				for (auto& leg : flight.chain)
+				{
+					auto& index = remap.at(leg.link);
+					if (index == Solvers::LinkPool::none)
+					{
+						index = pool->Add(Link::Link(flight.links->Get(leg.link)));
+					}
+					leg.link = index;
+				}
+				flight.links = pool;
+			}
+
+		private:
+			std::shared_ptr<Solvers::LinkPool> pool;
+			std::map<std::shared_ptr<const Solvers::LinkPool>, std::vector<Solvers::LinkPool::index>> remaps; // by source pools
+		};
+	}
+
 	PathFinder::PathFinder(Mission&& inMission)
 		: mission(std::move(inMission))
+		, links(std::make_shared<Solvers::LinkPool>())
 	{
 		if (mission.nodes.size() < 2)
 		{
@@ -23,12 +85,148 @@ namespace Pathfinder
 				throw std::runtime_error("ephemeride connection must be defined");
 			}
 		}
+		if (mission.faxConfig.legCacheLimit > 0)
+		{
+			// \note: a leg is solved once per time fraction, so the departure states must not change inside of it
+			for (auto& node : mission.nodes)
+			{
+				auto [asScript, asStatic] = Nodes::CastNode(node);
+				if (asScript && asScript->Script->GetStepSize() != mission.faxConfig.timeFrac)
+				{
+					throw std::runtime_error("leg cache requires discrete ephemerides with the step of the time fraction");
+				}
+			}
+			legCache = std::make_shared<Solvers::LegCache>(mission.faxConfig.timeFrac, mission.faxConfig.legCacheLimit);
+		}
+		if (mission.faxConfig.pruneTopK > 0)
+		{
+			incumbent = std::make_shared<Solvers::Incumbent>(mission.faxConfig.pruneTopK);
+		}
+	}
+
+	auto PathFinder::FirstApproxAt(FReal t0) -> std::vector<FlightChain>
+	{
+		if (!incumbent)
+		{
+			return Solvers::FirstApprox(mission, t0, legCache.get());
+		}
+		if (!functionality || !partialBound)
+		{
+			throw std::runtime_error("functionality and partial bound must be set for branch and bound");
+		}
+		auto pruning = Solvers::Utiles::Pruning{ functionality, partialBound, *incumbent };
+		return Solvers::FirstApprox(mission, t0, legCache.get(), &pruning);
 	}
 
 	auto PathFinder::FirstApprox(FReal timeOffset) -> const std::vector<FlightChain>&
 	{
 		auto t0 = mission.t0 + timeOffset;
-		return firstApproxDB[t0] = Solvers::FirstApprox(mission, t0);
+		return MergeFirstApprox(t0, FirstApproxAt(t0));
+	}
+
+	auto PathFinder::MergeFirstApprox(FReal t0, std::vector<FlightChain>&& flights) -> const std::vector<FlightChain>&
+	{
+		// \note: the kept flights' links are moved to the finder's pool, so the run's pool with its dead branches is freed
+		auto& merged = firstApproxDB[t0] = std::move(flights);
+		if (!resultsFilter)
+		{
+			std::for_each(merged.begin(), merged.end(), LinkMover(links));
+			return merged;
+		}
+		if (!functionality)
+		{
+			throw std::runtime_error("functionality must be set for the online filter");
+		}
+
+		auto values = std::vector<FReal>();
+		values.reserve(merged.size());
+		for (auto& flight : merged)
+		{
+			resultsFilter->Offer(values.emplace_back(functionality(flight)));
+		}
+
+		auto threshold = resultsFilter->GetThreshold();
+		auto kept = size_t(0);
+		for (size_t i = 0; i < merged.size(); ++i)
+		{
+			if (!(values[i] > threshold))
+			{
+				if (kept != i)
+				{
+					merged[kept] = std::move(merged[i]);
+				}
+				++kept;
+			}
+		}
+		merged.resize(kept);
+		std::for_each(merged.begin(), merged.end(), LinkMover(links));
+
+		// \note: the earlier dates are refiltered only when the DB doubles, so each flight is checked O(1) times on average
+		mergedSize += merged.size();
+		if (mergedSize > 2 * Math::Max(compactedSize, size_t(1024)))
+		{
+			compactedSize = mergedSize = FilterFirstApproxDB(threshold, false);
+		}
+		return merged;
+	}
+
+	void PathFinder::FirstApprox(const std::vector<FReal>& timeOffsets, size_t threads, OnFirstApprox onDone)
+	{
+		auto results = std::vector<std::vector<FlightChain>>(timeOffsets.size());
+		auto bReady  = std::vector<bool>(timeOffsets.size(), false);
+		auto mutex   = std::mutex();
+		auto nextToMerge = size_t(0);
+
+		Parallel::For(timeOffsets.size(), threads, [&](size_t i)
+		{
+			auto flights = FirstApproxAt(mission.t0 + timeOffsets[i]);
+
+			auto lock = std::lock_guard(mutex);
+			results[i] = std::move(flights);
+			bReady [i] = true;
+			
+			// merge all the finished offsets that precede the first unfinished one
+			for (; nextToMerge < results.size() && bReady[nextToMerge]; ++nextToMerge)
+			{
+				auto  offset = timeOffsets[nextToMerge];
+				auto& merged = MergeFirstApprox(mission.t0 + offset, std::move(results[nextToMerge]));
+				if (onDone)
+				{
+					onDone(offset, merged);
+				}
+			}
+		});
+
+		if (resultsFilter)
+		{
+			compactedSize = mergedSize = FilterFirstApproxDB(resultsFilter->GetThreshold(), true);
+			if (auto topK = resultsFilter->GetSettings().topK; topK > 0 && mergedSize > topK)
+			{
+				KeepBestResults(topK);
+			}
+		}
+	}
+
+	void PathFinder::RestoreFirstApprox(FReal timeOffset, std::vector<FlightChain>&& flights)
+	{
+		MergeFirstApprox(mission.t0 + timeOffset, std::move(flights));
+	}
+
+	void PathFinder::SetOnlineFilter(const OnlineFilter& filter)
+	{
+		if (firstApproxDB.size())
+		{
+			throw std::runtime_error("online filter must be set before the first approximation");
+		}
+		resultsFilter = filter.topK > 0 || !isnan(filter.keepFactor)
+			? std::make_shared<Solvers::ResultsFilter>(filter)
+			: nullptr;
+	}
+
+	void PathFinder::SetThreads(size_t threads)
+	{
+		mission.faxConfig.threads = Int32(threads);
+		mission.saxConfig.threads = Int32(threads);
 	}
 
 	void PathFinder::SetFunctionality(Functionality functionality_)
@@ -36,12 +234,21 @@ namespace Pathfinder
 		functionality = functionality_;
 	}
 
+	void PathFinder::SetPartialBound(Functionality bound)
+	{
+		partialBound = bound;
+	}
+
 	auto PathFinder::GetFunctionalityBounds() const -> std::tuple<FReal, FReal>
 	{
 		if (!functionality)
 		{
 			throw std::runtime_error("functionality must be set to get functionality bounds");
 		}
+		if (resultsFilter)
+		{
+			return resultsFilter->GetBounds();
+		}
 
 		auto min = FReal(NAN);
 		auto max = FReal(NAN);
@@ -76,45 +283,242 @@ namespace Pathfinder
 			throw std::runtime_error("functionality must be set to filter first approx trajectories");
 		}
 
-		auto pos1 = firstApproxDB.begin();
-		while (pos1 != firstApproxDB.end())
+		FilterFirstApproxDB(minFunctionalityToLeft, true);
+	}
+
+	size_t PathFinder::KeepBestResults(size_t count)
+	{
+		if (!functionality)
 		{
-			auto& list = pos1->second;
-			auto  pos2 = list.begin();
-			while (pos2 != list.end())
+			throw std::runtime_error("functionality must be set to filter first approx trajectories");
+		}
+
+		auto values = std::vector<FReal>();
+		auto order  = std::vector<size_t>();
+		for (auto& [_, list] : firstApproxDB)
+		for (auto& flight : list)
+		{
+			if (!isnan(values.emplace_back(functionality(flight))))
 			{
-				auto value = functionality(*pos2);
-				if (value > minFunctionalityToLeft)
+				order.push_back(values.size() - 1);
+			}
+		}
+
+		// \note: ties are broken by the DB's order, so exactly 'count' flights are left
+		if (order.size() > count)
+		{
+			std::nth_element(order.begin(), order.begin() + count, order.end(), [&](size_t a, size_t b)
+			{
+				return std::tie(values[a], a) < std::tie(values[b], b);
+			});
+			order.resize(count);
+		}
+		auto bKept = std::vector<bool>(values.size(), false);
+		for (auto i : order)
+		{
+			bKept[i] = true;
+		}
+
+		// \note: the flights are visited in the order they were collected
+		auto i = size_t(0);
+		auto left = size_t(0);
+		for (auto pos = firstApproxDB.begin(); pos != firstApproxDB.end();)
+		{
+			auto& list = pos->second;
+			auto  kept = size_t(0);
+			for (size_t j = 0; j < list.size(); ++j, ++i)
+			{
+				if (!bKept[i])
+				{
+					continue;
+				}
+				if (kept != j)
 				{
-					pos2 = list.erase(pos2);
+					list[kept] = std::move(list[j]);
 				}
-				else ++pos2;
+				++kept;
 			}
+			list.resize(kept);
+			left += kept;
+
 			if (list.size() == 0)
 			{
-				pos1 = firstApproxDB.erase(pos1);
+				pos = firstApproxDB.erase(pos);
 			}
-			else ++pos1;
+			else ++pos;
 		}
+		compactedSize = mergedSize = left;
+		CompactLinks();
+		return left;
 	}
 
-	const PathFinder::SecondApproxDB& PathFinder::SecondApprox()
+	size_t PathFinder::ClusterResults(const SeedClustering& settings)
+	{
+		if (!functionality)
+		{
+			throw std::runtime_error("functionality must be set to cluster first approx trajectories");
+		}
+
+		auto flights = std::vector<const FlightChain*>();
+		auto values  = std::vector<FReal>();
+		for (auto& [_, list] : firstApproxDB)
+		for (auto& flight : list)
+		{
+			flights.push_back(&flight);
+			values .push_back(functionality(flight));
+		}
+		auto leaders = Solvers::ClusterFlights(flights, values, settings.timeRadius, settings.angleRadius);
+
+		// \note: the flights are visited in the order they were collected
+		auto i = size_t(0);
+		auto sizes = std::vector<Int32>(flights.size(), 0);
+		for (auto leader : leaders)
+		{
+			sizes[leader] += flights[i++]->clusterSize;
+		}
+
+		i = 0;
+		auto left = size_t(0);
+		for (auto pos = firstApproxDB.begin(); pos != firstApproxDB.end();)
+		{
+			auto& list = pos->second;
+			auto  kept = size_t(0);
+			for (size_t j = 0; j < list.size(); ++j, ++i)
+			{
+				if (leaders[i] != i)
+				{
+					continue;
+				}
+				list[j].clusterSize = sizes[i];
+				if (kept != j)
+				{
+					list[kept] = std::move(list[j]);
+				}
+				++kept;
+			}
+			list.resize(kept);
+			left += kept;
+
+			if (list.size() == 0)
+			{
+				pos = firstApproxDB.erase(pos);
+			}
+			else ++pos;
+		}
+		compactedSize = mergedSize = left;
+		CompactLinks();
+		return left;
+	}
+
+	size_t PathFinder::FilterFirstApproxDB(FReal threshold, bool bEraseEmpty)
+	{
+		auto left = size_t(0);
+		auto pos  = firstApproxDB.begin();
+		while (pos != firstApproxDB.end())
+		{
+			auto& list = pos->second;
+			list.erase(std::remove_if(list.begin(), list.end(), [&](const FlightChain& flight)
+			{
+				return functionality(flight) > threshold;
+			}), list.end());
+
+			left += list.size();
+			if (bEraseEmpty && list.size() == 0)
+			{
+				pos = firstApproxDB.erase(pos);
+			}
+			else ++pos;
+		}
+		CompactLinks();
+		return left;
+	}
+
+	void PathFinder::CompactLinks()
+	{
+		links = std::make_shared<Solvers::LinkPool>();
+		auto mover = LinkMover(links);
+		for (auto& [_, list] : firstApproxDB)
+		for (auto& flight : list)
+		{
+			mover(flight);
+		}
+		for (auto& [_, data] : secondApproxDB)
+		{
+			mover(data.chain);
+		}
+	}
+
+	const PathFinder::SecondApproxDB& PathFinder::SecondApprox(OnSecondApprox onDone)
 	{
 		if (!functionality)
 		{
 			throw std::runtime_error("functionality must be set for the operation");
 		}
 
+		auto seeds = std::vector<std::tuple<Int64, const FlightChain*>>();
 		for (auto& [t0, flights] : firstApproxDB)
 		{
 			for (auto& flight : flights)
 			{
-				SecondApprox(flight, t0);
+				seeds.emplace_back(t0, &flight);
+			}
+		}
+
+		// each worker creates its own minimiser, so the only shared state is the sink
+		// \note: a sink's slot is written by exactly one worker; the slots are inserted in the seeds' order
+		auto sink  = std::vector<std::optional<SecondApproxData>>(seeds.size());
+		auto mutex = std::mutex();
+		Parallel::For(seeds.size(), mission.saxConfig.threads, [&](size_t i)
+		{
+			auto& seed = *std::get<1>(seeds[i]);
+			if (restoredSAX.size())
+			{
+				if (auto pos = restoredSAX.find(GetSeedKey(seed)); pos != restoredSAX.end())
+				{
+					sink[i] = pos->second;
+					if (sink[i])
+					{
+						sink[i]->chain.clusterSize = seed.clusterSize;
+					}
+					return;
+				}
+			}
+
+			sink[i] = SecondApprox(seed);
+			if (onDone)
+			{
+				auto lock = std::lock_guard(mutex);
+				onDone(seed, sink[i]);
+			}
+		});
+
+		auto mover = LinkMover(links);
+		for (size_t i = 0; i < seeds.size(); ++i)
+		{
+			if (sink[i])
+			{
+				mover(sink[i]->chain);
+				secondApproxDB.insert({ std::get<0>(seeds[i]), std::move(*sink[i]) });
 			}
 		}
 		return secondApproxDB;
 	}
 
+	void PathFinder::RestoreSecondApprox(const FlightChain& seed, std::optional<SecondApproxData>&& result)
+	{
+		restoredSAX[GetSeedKey(seed)] = std::move(result);
+	}
+
+	auto PathFinder::GetLegCacheStats() const -> LegCacheStats
+	{
+		return legCache ? legCache->GetStats() : LegCacheStats();
+	}
+
+	UInt64 PathFinder::GetPrunedCount() const
+	{
+		return incumbent ? incumbent->GetPruned() : 0;
+	}
+
 	size_t PathFinder::FAXDBSize() const
 	{
 		size_t size = 0;
@@ -140,18 +544,24 @@ namespace Pathfinder
 		return secondApproxDB;
 	}
 
-	void PathFinder::SecondApprox(const FlightChain& flight, Int64 t0)
+	auto PathFinder::SecondApprox(const FlightChain& flight) const -> std::optional<SecondApproxData>
 	{
-		auto [chain, value] = Solvers::SecondApprox(mission, flight, functionality);
+		auto timer = saxTime.Measure();
+		auto evaluations = UInt64(0);
+		auto [chain, value] = Solvers::SecondApprox(mission, flight, functionality, &evaluations);
+		saxEvaluations.Observe(FReal(evaluations));
 		if (isnan(value))
 		{
-			return;
+			saxFailed.Add();
+			return std::nullopt;
 		}
-		secondApproxDB.insert({ t0, {std::move(chain), value} });
+		chain.clusterSize = flight.clusterSize;
+		return SecondApproxData{ std::move(chain), value, evaluations };
 	}
 	
-	PathFinder::FlightChain::FlightChain(std::vector<PathFinder::FlightInfo>&& chain_)
+	PathFinder::FlightChain::FlightChain(std::vector<FlightLeg>&& chain_, std::shared_ptr<const Solvers::LinkPool> links_)
 		: chain(std::move(chain_))
+		, links(std::move(links_))
 	{
 		auto& last = chain.back();
 		Correction = last.totalCorrection;
@@ -159,7 +569,65 @@ namespace Pathfinder
 		Impulse = last.totalImpulse;
 		totalTime = last.totalTime;
 
-		auto& first = chain.front();
-		startTime = first.link.t0;
+		startTime = GetLink(0).t0;
+	}
+
+	const Link::Link& PathFinder::FlightChain::GetLink(size_t leg) const
+	{
+		if (!links)
+		{
+			throw std::runtime_error("flight chain has no links");
+		}
+		return links->Get(chain.at(leg).link);
+	}
+
+	PathFinder::FlightRecord::FlightRecord(const FlightChain& flight)
+		: chain(flight.chain.size())
+	{
+		for (size_t i = 0; i < chain.size(); ++i)
+		{
+			auto& info = chain[i];
+			auto& leg = flight.chain[i];
+			info.totalCorrection = leg.totalCorrection;
+			info.totalMismatch = leg.totalMismatch;
+			info.totalImpulse = leg.totalImpulse;
+			info.totalTime = leg.totalTime;
+			info.absTime = leg.absTime;
+			info.link = flight.GetLink(i);
+		}
+		Correction = flight.Correction;
+		Mismatch = flight.Mismatch;
+		Impulse = flight.Impulse;
+		totalTime = flight.totalTime;
+		startTime = flight.startTime;
+		clusterSize = flight.clusterSize;
+	}
+
+	auto PathFinder::FlightRecord::ToChain() const -> FlightChain
+	{
+		auto pool = std::make_shared<Solvers::LinkPool>();
+		pool->Reserve(chain.size());
+
+		auto flight = FlightChain();
+		flight.chain.resize(chain.size());
+		for (size_t i = 0; i < chain.size(); ++i)
+		{
+			auto& info = chain[i];
+			auto& leg = flight.chain[i];
+			leg.totalCorrection = info.totalCorrection;
+			leg.totalMismatch = info.totalMismatch;
+			leg.totalImpulse = info.totalImpulse;
+			leg.totalTime = info.totalTime;
+			leg.absTime = info.absTime;
+			leg.link = pool->Add(Link::Link(info.link));
+		}
+		flight.Correction = Correction;
+		flight.Mismatch = Mismatch;
+		flight.Impulse = Impulse;
+		flight.totalTime = totalTime;
+		flight.startTime = startTime;
+		flight.clusterSize = clusterSize;
+		flight.links = std::move(pool);
+		return flight;
 	}
 }
@@ -2,12 +2,15 @@
 #define PATHFINDER__FIRSTAPPROX_HPP
 
 #include "pathfinder.hpp"
+#include "solvers/Utiles.hpp"
 
 
 
 namespace Pathfinder::Solvers
 {
-	auto FirstApprox(const Mission& mission, FReal t0)->std::vector<PathFinder::FlightChain>;
+	class LegCache;
+
+	auto FirstApprox(const Mission& mission, FReal t0, LegCache* cache = nullptr, const Utiles::Pruning* pruning = nullptr)->std::vector<PathFinder::FlightChain>;
 }
 
 
@@ -5,7 +5,7 @@
 
 namespace Pathfinder::Solvers
 {
-	auto FirstApprox(const Mission& mission, FReal t0) -> std::vector<PathFinder::FlightChain>
+	auto FirstApprox(const Mission& mission, FReal t0, LegCache* cache, const Utiles::Pruning* pruning) -> std::vector<PathFinder::FlightChain>
 	{
 		auto f0s = Utiles::MakeRange(0, 2 * Math::Pi, mission.faxConfig.points_f0);
 		auto seq = std::vector<Utiles::NodeA>();
@@ -13,6 +13,6 @@ namespace Pathfinder::Solvers
 		{
 			seq.push_back({ node, f0s });
 		}
-		return ComputeFlight(mission.faxConfig, seq, t0, mission.GM);
+		return ComputeFlight(mission.faxConfig, seq, t0, mission.GM, false, cache, pruning);
 	}
 }
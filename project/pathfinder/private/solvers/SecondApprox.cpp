@@ -1,10 +1,13 @@
 #include "trajectory/keplerOrbit.hpp"
 #include "solvers/SecondApprox.hpp"
 #include "solvers/Utiles.hpp"
+#include "solvers/chainEvaluator.hpp"
 #include "defer.hpp"
+#include "parallel.hpp"
 
 #include <gsl/gsl_multimin.h>
 #include <gsl/gsl_errno.h>
+#include <random>
 
 
 
@@ -82,8 +85,12 @@ namespace Pathfinder::Solvers::Utiles
 		using FlightChain = PathFinder::FlightChain;
 
 		using Functor       = gsl_multimin_function;
+		using FunctorFDF    = gsl_multimin_function_fdf;
 		using GSL_vector    = gsl_vector*;
 		using GSL_minimiser = gsl_multimin_fminimizer*;
+		using GSL_minimiserFDF = gsl_multimin_fdfminimizer*;
+		using Workers = std::vector<std::unique_ptr<SecondApproxHelper>>;
+		using Point   = std::vector<FReal>; // variables scaled by the initial steps (see Unscale)
 
 	public:
 		int k = 0; // number of flights
@@ -95,10 +102,18 @@ namespace Pathfinder::Solvers::Utiles
 		GSL_vector    ss = nullptr;
 		GSL_minimiser mz = nullptr;
 
+		// << gsl entry of the gradient minimisers
+		// \note: they work with variables scaled by the initial steps (the variables' units differ a lot)
+		FunctorFDF       fdf;
+		GSL_vector       xs  = nullptr; // unscaled variables
+		GSL_minimiserFDF mzg = nullptr;
+		Workers workers; // helpers evaluating the differences (a helper's chain is its state)
+
 		FReal t  = 0;
 		FReal GM = 0;
 
 		Chain chain;
+		std::unique_ptr<ChainEvaluator> evaluator; // evaluates the chain while minimising
 		Mapper functionality;
 		TossAgles tossAngles;
 		BurnNodes burnNodes;
@@ -106,17 +121,28 @@ namespace Pathfinder::Solvers::Utiles
 		
 		FReal curFunctionality = NAN;
 		FlightChain currentFlight;
+		UInt64 evaluations = 0;
+		UInt64 evaluationLimit = 0; // evaluations the local minimisation can use (0 - no limit)
 
 		const SAXConfig& mission;
+		const Mission& source;
+		const FlightChain& seed;
 
 	public:
 		SecondApproxHelper(const Mission& mission, const PathFinder::FlightChain& flight, const PathFinder::Functionality& functionality)
 			: mission(mission.saxConfig)
+			, source(mission)
+			, seed(flight)
 			, k(flight.chain.size())
 			, m(flight.chain.size()*5 + 1)
 			, functionality(functionality)
 			, GM(mission.GM)
 		{
+			if (this->mission.linkSolver != ELinkSolver::eScan)
+			{
+				throw std::runtime_error("SAX optimises toss angles, so its legs must be solved with ELinkSolver::eScan");
+			}
+
 			// create a list of toss angles
 			// \note: born nodes are included too
 			for (auto i = 0; i < m; ++i)
@@ -132,6 +158,7 @@ namespace Pathfinder::Solvers::Utiles
 			burnNodes.reserve(k);
 			fieldMap .SetSize(m);
 			ParseFlight(flight, mission.nodes);
+			evaluator = std::make_unique<ChainEvaluator>(this->mission, chain, GM, true);
 
 			// create a functor
 			fr.params = this;
@@ -147,7 +174,9 @@ namespace Pathfinder::Solvers::Utiles
 		{
 			if (x0) gsl_vector_free(x0);
 			if (ss) gsl_vector_free(ss);
+			if (xs) gsl_vector_free(xs);
 			if (mz) gsl_multimin_fminimizer_free(mz);
+			if (mzg) gsl_multimin_fdfminimizer_free(mzg);
 		}
 
 		void ParseFlight(const PathFinder::FlightChain& flight, const Mission::Nodes& nodes)
@@ -170,8 +199,9 @@ namespace Pathfinder::Solvers::Utiles
 				{
 					burnNodes.push_back(burn);
 
-					auto [R, f] = Utiles::GetBurnParams(fpos->link, mission.burnArcFraction);
-					fieldMap.Assign(fieldOffset + 0, tossAngles[chainOffset + 0][0]) = fpos->link.f0;
+					auto& link = flight.GetLink(size_t(fpos - flight.chain.begin()));
+					auto [R, f] = Utiles::GetBurnParams(link, mission.burnArcFraction);
+					fieldMap.Assign(fieldOffset + 0, tossAngles[chainOffset + 0][0]) = link.f0;
 					fieldMap.Assign(fieldOffset + 1, tossAngles[chainOffset + 1][0]) = f;
 					fieldMap.Assign(fieldOffset + 2, burn->R.x) = R.x;
 					fieldMap.Assign(fieldOffset + 3, burn->R.y) = R.y;
@@ -196,14 +226,46 @@ namespace Pathfinder::Solvers::Utiles
 
 		bool InitMinimiser()
 		{
-			if (mz)	return true;
+			if (mz || mzg)	return true;
 
 			gsl_set_error_handler_off();
 
-			auto T = gsl_multimin_fminimizer_nmsimplex2;
-			mz = gsl_multimin_fminimizer_alloc(T, m);
-			
-			auto status = gsl_multimin_fminimizer_set(mz, &fr, x0, ss);
+			auto status = int(GSL_SUCCESS);
+			switch (mission.minimiser)
+			{
+			case ESAXMinimiser::eSimplex:
+			{
+				auto T = gsl_multimin_fminimizer_nmsimplex2;
+				mz = gsl_multimin_fminimizer_alloc(T, m);
+				status = gsl_multimin_fminimizer_set(mz, &fr, x0, ss);
+				break;
+			}
+			case ESAXMinimiser::eBFGS2:
+			case ESAXMinimiser::eConjugate:
+			{
+				InitGradient();
+				auto T = mission.minimiser == ESAXMinimiser::eBFGS2
+					? gsl_multimin_fdfminimizer_vector_bfgs2
+					: gsl_multimin_fdfminimizer_conjugate_pr
+					;
+				// \note: the scaled seed is (x0 / ss), and the first trial step is one initial step
+				auto y0 = gsl_vector_alloc(m);
+				DEFER(_)[y0]()
+				{
+					gsl_vector_free(y0);
+				};
+				for (auto i = 0; i < m; ++i)
+				{
+					gsl_vector_set(y0, i, gsl_vector_get(x0, i) / gsl_vector_get(ss, i));
+				}
+				mzg = gsl_multimin_fdfminimizer_alloc(T, m);
+				status = gsl_multimin_fdfminimizer_set(mzg, &fdf, y0, 1., 0.1);
+				break;
+			}
+			default:
+				throw std::runtime_error("unexpected SAX minimiser: " + std::to_string((int)mission.minimiser));
+			}
+
 			if (status == GSL_SUCCESS || status == GSL_EBADFUNC)
 			{
 				return !status;
@@ -211,16 +273,152 @@ namespace Pathfinder::Solvers::Utiles
 			throw std::runtime_error("Unexpected status from minimiser initialisation: " + std::to_string(status));
 		}
 
+		void InitGradient()
+		{
+			xs = gsl_vector_alloc(m);
+			fdf.params = this;
+			fdf.n = m;
+			fdf.f = [](const gsl_vector* y, void* params)->double
+			{
+				auto self = (SecondApproxHelper*)params;
+				self->Unscale(y, self->xs);
+				return self->ComputeFunctionality(self->xs);
+			};
+			fdf.df = [](const gsl_vector* y, void* params, gsl_vector* g)
+			{
+				auto self = (SecondApproxHelper*)params;
+				self->ComputeGradient(y, g);
+			};
+			fdf.fdf = [](const gsl_vector* y, void* params, double* f, gsl_vector* g)
+			{
+				auto self = (SecondApproxHelper*)params;
+				self->Unscale(y, self->xs);
+				*f = self->ComputeFunctionality(self->xs);
+				self->ComputeGradient(y, g);
+			};
+
+			InitWorkers(m);
+		}
+
+		// creates helpers evaluating up to 'tasks' points in parallel
+		// \note: inside a worker of the SAX's sweep the points are evaluated sequentially
+		void InitWorkers(size_t tasks)
+		{
+			if (workers.size())
+			{
+				return;
+			}
+			auto count = Parallel::IsWorker() ? size_t(1) : std::min(Parallel::GetWorkersCount(mission.threads), tasks);
+			for (size_t i = 0; i < Math::Max(count, size_t(1)); ++i)
+			{
+				workers.push_back(std::make_unique<SecondApproxHelper>(source, seed, functionality));
+			}
+		}
+
+		Point GetScaledSeed() const
+		{
+			auto y = Point(m);
+			for (auto i = 0; i < m; ++i)
+			{
+				y[i] = gsl_vector_get(x0, i) / gsl_vector_get(ss, i);
+			}
+			return y;
+		}
+
+		void SetStart(const Point& y)
+		{
+			for (auto i = 0; i < m; ++i)
+			{
+				gsl_vector_set(x0, i, y[i] * gsl_vector_get(ss, i));
+			}
+		}
+
+		// evaluates the points with the workers in parallel (a worker takes a contiguous block)
+		void EvaluatePoints(const std::vector<Point>& points, std::vector<FReal>& values)
+		{
+			InitWorkers(points.size());
+			values.resize(points.size());
+			const auto count = workers.size();
+			Parallel::For(count, count, [&](size_t w)
+			{
+				auto& worker = *workers[w];
+				auto  x = worker.x0;
+				for (auto i = points.size() * w / count; i < points.size() * (w + 1) / count; ++i)
+				{
+					for (auto j = 0; j < m; ++j)
+					{
+						gsl_vector_set(x, j, points[i][j] * gsl_vector_get(ss, j));
+					}
+					values[i] = worker.ComputeFunctionality(x);
+				}
+			});
+		}
+
+		void Unscale(const gsl_vector* y, gsl_vector* x) const
+		{
+			for (auto i = 0; i < m; ++i)
+			{
+				gsl_vector_set(x, i, gsl_vector_get(y, i) * gsl_vector_get(ss, i));
+			}
+		}
+
+		// central differences of the scaled variables, computed by the workers in parallel
+		// \note: a component the flight cannot be computed for on either side is zeroed
+		void ComputeGradient(const gsl_vector* y, gsl_vector* g)
+		{
+			const auto h = mission.gradientStep;
+			const auto count = workers.size();
+			Parallel::For(count, count, [&](size_t w)
+			{
+				auto& worker = *workers[w];
+				auto  x = worker.x0;
+				Unscale(y, x);
+				for (auto i = m * w / count; i < m * (w + 1) / count; ++i)
+				{
+					auto xi = gsl_vector_get(x, i);
+					auto hi = h * gsl_vector_get(ss, i);
+					gsl_vector_set(x, i, xi + hi);
+					auto fp = worker.ComputeFunctionality(x);
+					gsl_vector_set(x, i, xi - hi);
+					auto fm = worker.ComputeFunctionality(x);
+					gsl_vector_set(x, i, xi);
+
+					auto gi = (fp - fm) / (2 * h);
+					gsl_vector_set(g, i, isnan(gi) ? 0. : gi);
+				}
+			});
+		}
+
+		UInt64 GetEvaluations() const
+		{
+			auto total = evaluations;
+			for (auto& worker : workers)
+			{
+				total += worker->evaluations;
+			}
+			return total;
+		}
+
 	public:
 
 		double ComputeFunctionality(const gsl_vector* v)
 		{
 			assert(functionality);
+			++evaluations;
+			fieldMap.ReadVector(v);
+			return evaluator->Evaluate(t, functionality);
+		}
+
+		// computes the flights of the point and keeps the best one as the result
+		void ComputeResult(const gsl_vector* v)
+		{
+			assert(functionality);
+			++evaluations;
 			fieldMap.ReadVector(v);
 			auto results = ComputeFlight(mission, chain, t, GM, true);
 			if (!results.size())
 			{
-				return NAN;
+				return;
 			}
 			
 			int i_min = 0;
@@ -236,29 +434,53 @@ namespace Pathfinder::Solvers::Utiles
 			}
 			curFunctionality = min;
 			std::swap(currentFlight, results[i_min]);
-
-			return min;
 		}
 
+		// \note: the result is computed at the minimiser's point, even if the minimisation failed
 		bool FindMinimum()
 		{
 			if (!InitMinimiser())
 			{
+				ComputeResult(x0);
 				return false;
 			}
 
+			auto bOK = Minimise();
+			if (mz)
+			{
+				ComputeResult(mz->x);
+			}
+			else
+			{
+				Unscale(gsl_multimin_fdfminimizer_x(mzg), xs);
+				ComputeResult(xs);
+			}
+			return bOK;
+		}
+
+		bool Minimise()
+		{
 			auto status = int(GSL_CONTINUE);
 			auto prevValue = FReal(NAN);
 			auto min_delta = mission.minMinimisationDelta;
 			auto max_iter = mission.maxMinimisationIters;
 			for (int iter = 0; status == GSL_CONTINUE && iter < max_iter; ++iter)
 			{
-				if (status = gsl_multimin_fminimizer_iterate(mz))
+				if (evaluationLimit && GetEvaluations() >= evaluationLimit)
 				{
+					break;
+				}
+				if (status = Iterate())
+				{
+					// \note: a gradient minimiser stops making progress at its minimum
+					if (mzg && status == GSL_ENOPROG)
+					{
+						break;
+					}
 					return false;
 				}
 
-				FReal curValue = mz->fval;
+				FReal curValue = GetMinimum();
 				if (!isnan(prevValue))
 				{
 					auto delta = Math::Abs(curValue - prevValue);
@@ -270,24 +492,208 @@ namespace Pathfinder::Solvers::Utiles
 				}
 				prevValue = curValue;
 			}
-			ComputeFunctionality(mz->x);
 			return true;
 		}
+
+		int Iterate()
+		{
+			return mz 
+				? gsl_multimin_fminimizer_iterate(mz) 
+				: gsl_multimin_fdfminimizer_iterate(mzg)
+				;
+		}
+
+		FReal GetMinimum() const
+		{
+			return mz 
+				? mz->fval 
+				: gsl_multimin_fdfminimizer_minimum(mzg)
+				;
+		}
 	};
 }
 
 
+namespace Pathfinder::Solvers::Utiles
+{
+	// checks whether a value is better than another one (NAN is the worst value)
+	bool IsBetter(FReal value, FReal than)
+	{
+		return !isnan(value) && (isnan(than) || value <= than);
+	}
+
+	// draws a point around the center in the box of the given half width
+	auto DrawPoint(const SecondApproxHelper::Point& center, FReal spread, std::mt19937_64& rng) -> SecondApproxHelper::Point
+	{
+		auto U = std::uniform_real_distribution<FReal>(-spread, spread);
+		auto y = center;
+		for (auto& yi : y)
+		{
+			yi += U(rng);
+		}
+		return y;
+	}
+
+	// differential evolution (rand/1/bin) in the box around the seed; the seed is a member of the population
+	// \note: the points are drawn sequentially and evaluated in parallel, so the search doesn't depend on the workers
+	void FindGlobalMinimum_DE(SecondApproxHelper& helper, std::mt19937_64& rng)
+	{
+		using Point = SecondApproxHelper::Point;
+		const auto& conf = helper.mission;
+		const auto  NP = size_t(Math::Max(conf.globalPopulation, 4));
+		const auto  m  = size_t(helper.m);
+
+		auto population = std::vector<Point>();
+		auto seed = helper.GetScaledSeed();
+		population.push_back(seed);
+		while (population.size() < NP)
+		{
+			population.push_back(DrawPoint(seed, conf.globalSpread, rng));
+		}
+		auto values = std::vector<FReal>();
+		helper.EvaluatePoints(population, values);
+
+		auto trials = std::vector<Point>(NP, Point(m));
+		auto trialValues = std::vector<FReal>();
+		auto U = std::uniform_real_distribution<FReal>(0, 1);
+		auto I = std::uniform_int_distribution<size_t>(0, NP - 1);
+		auto J = std::uniform_int_distribution<size_t>(0, m - 1);
+		for (auto used = NP; used + NP <= conf.evaluationBudget; used += NP)
+		{
+			for (size_t i = 0; i < NP; ++i)
+			{
+				size_t a, b, c;
+				do a = I(rng); while (a == i);
+				do b = I(rng); while (b == i || b == a);
+				do c = I(rng); while (c == i || c == a || c == b);
+
+				auto jr = J(rng);
+				for (size_t j = 0; j < m; ++j)
+				{
+					trials[i][j] = U(rng) < conf.deCrossover || j == jr
+						? population[a][j] + conf.deWeight * (population[b][j] - population[c][j])
+						: population[i][j]
+						;
+				}
+			}
+
+			helper.EvaluatePoints(trials, trialValues);
+			for (size_t i = 0; i < NP; ++i)
+			{
+				if (IsBetter(trialValues[i], values[i]))
+				{
+					std::swap(population[i], trials[i]);
+					values[i] = trialValues[i];
+				}
+			}
+		}
+
+		auto best = size_t(0);
+		for (size_t i = 1; i < NP; ++i)
+		{
+			if (IsBetter(values[i], values[best]) && values[i] != values[best])
+			{
+				best = i;
+			}
+		}
+		helper.SetStart(population[best]);
+		helper.ComputeResult(helper.x0);
+	}
+
+	// local minimisations from the seed and from points drawn around it, run in parallel
+	// \note: each restart can use its share of the budget; the first restart is the plain local SAX
+	auto FindGlobalMinimum_MultiStart(
+		  const Mission& mission
+		, const PathFinder::FlightChain& flight
+		, const PathFinder::Functionality& functionality
+		, std::mt19937_64& rng
+	) -> std::tuple<PathFinder::FlightChain, FReal, UInt64>
+	{
+		using Point = SecondApproxHelper::Point;
+		const auto& conf = mission.saxConfig;
+		const auto  restarts = size_t(Math::Max(conf.globalPopulation, 1));
+
+		auto starts = std::vector<Point>();
+		{
+			auto helper = SecondApproxHelper(mission, flight, functionality);
+			auto seed = helper.GetScaledSeed();
+			starts.push_back(seed);
+			while (starts.size() < restarts)
+			{
+				starts.push_back(DrawPoint(seed, conf.globalSpread, rng));
+			}
+		}
+
+		auto results = std::vector<std::tuple<PathFinder::FlightChain, FReal, UInt64>>(restarts);
+		Parallel::For(restarts, conf.threads, [&](size_t i)
+		{
+			auto helper = SecondApproxHelper(mission, flight, functionality);
+			helper.evaluationLimit = Math::Max(conf.evaluationBudget / restarts, UInt64(1));
+			helper.SetStart(starts[i]);
+			helper.FindMinimum();
+			results[i] = { std::move(helper.currentFlight), helper.curFunctionality, helper.GetEvaluations() };
+		});
+
+		auto best = size_t(0);
+		auto evaluations = UInt64(0);
+		for (size_t i = 0; i < restarts; ++i)
+		{
+			evaluations += std::get<2>(results[i]);
+			if (IsBetter(std::get<1>(results[i]), std::get<1>(results[best])) && std::get<1>(results[i]) != std::get<1>(results[best]))
+			{
+				best = i;
+			}
+		}
+		return { std::move(std::get<0>(results[best])), std::get<1>(results[best]), evaluations };
+	}
+}
+
+
 namespace Pathfinder::Solvers
 {
 	std::tuple<PathFinder::FlightChain, FReal> SecondApprox(
 		  const Mission& mission
 		, const PathFinder::FlightChain& flight
 		, const PathFinder::Functionality& functionality
+		, UInt64* evaluations
 		// , FReal tMin
 		// , FReal tMax
 	) {
+		auto rng = std::mt19937_64(mission.saxConfig.randomSeed);
+		switch (mission.saxConfig.global)
+		{
+		case ESAXGlobal::eNone:
+			break;
+		case ESAXGlobal::eDifferentialEvolution:
+		{
+			auto helper = Utiles::SecondApproxHelper(mission, flight, functionality);
+			Utiles::FindGlobalMinimum_DE(helper, rng);
+			if (evaluations)
+			{
+				*evaluations = helper.GetEvaluations();
+			}
+			return { helper.currentFlight, helper.curFunctionality };
+		}
+		case ESAXGlobal::eMultiStart:
+		{
+			auto [best, value, used] = Utiles::FindGlobalMinimum_MultiStart(mission, flight, functionality, rng);
+			if (evaluations)
+			{
+				*evaluations = used;
+			}
+			return { std::move(best), value };
+		}
+		default:
+			throw std::runtime_error("unexpected SAX global search: " + std::to_string((int)mission.saxConfig.global));
+		}
+
 		auto helper = Utiles::SecondApproxHelper(mission, flight, functionality);
-		if (!helper.FindMinimum() && isnan(helper.curFunctionality))
+		auto bFound = helper.FindMinimum();
+		if (evaluations)
+		{
+			*evaluations = helper.GetEvaluations();
+		}
+		if (!bFound && isnan(helper.curFunctionality))
 		{
 			return { {}, NAN };
 		}
@@ -7,10 +7,12 @@
 
 namespace Pathfinder::Solvers
 {
+	// \note: evaluations (optional) - count of the functionality's evaluations the minimiser used
 	std::tuple<PathFinder::FlightChain, FReal> SecondApprox(
 		  const Mission& mission
 		, const PathFinder::FlightChain& flight
 		, const PathFinder::Functionality& functionality
+		, UInt64* evaluations = nullptr
 		// , FReal tMin
 		// , FReal tMax
 	);
@@ -1,12 +1,36 @@
 #include "solvers/Utiles.hpp"
 #include "solvers/pathTree.hpp"
+#include "solvers/legCache.hpp"
+#include "solvers/linkPool.hpp"
+#include "solvers/incumbent.hpp"
 #include "blocks/link.hpp"
-#include <deque>
+#include "parallel.hpp"
+#include "metrics.hpp"
+#include <utility>
 
 
 
 namespace Pathfinder::Solvers::Utiles
 {
+	namespace
+	{
+		const auto findLinksTime  = Metrics::Timer    ("Link.FindLinks.time");
+		const auto findLinksCount = Metrics::Histogram("Link.FindLinks.links");
+		const auto flightTime     = Metrics::Timer    ("ComputeFlight.time");
+		const auto flightCount    = Metrics::Histogram("ComputeFlight.flights");
+		const auto checks         = Metrics::Counter  ("INode.Check.calls");
+		const auto rejected       = Metrics::Counter  ("INode.Check.rejected");
+	}
+
+	void CountCheck(bool bOK)
+	{
+		checks.Add();
+		if (!bOK)
+		{
+			rejected.Add();
+		}
+	}
+
 	FReal GetFlyTimeLimit(FReal r0, FReal r1, FReal factor, FReal GM)
 	{
 		const auto a = Math::Avg(r0, r1);
@@ -33,6 +57,8 @@ namespace Pathfinder::Solvers::Utiles
 		, FReal t0
 		, FReal GM
 	) {
+		auto timer = findLinksTime.Measure();
+		auto count = links.size();
 		auto SetA_GM_t0 = [&A, t0, GM](auto& conf)
 		{
 			auto [asScript, asStatic] = ::Pathfinder::Nodes::CastNode(A);
@@ -57,8 +83,14 @@ namespace Pathfinder::Solvers::Utiles
 			conf.ts = mission.timeStep;
 			conf.td = mission.timeFrac;
 			conf.tt = mission.timeTol;
+			conf.threads = mission.threads;
+			conf.polisher = mission.rootPolisher;
 			conf.te = t0 + GetFlyTimeLimit(conf.RA.Size(), conf.B.GetLocation().Size(), mission.normalFlyPeriodFactor, GM);
-			Link::FindLinks(links, conf, f0s);
+			if (mission.linkSolver == ELinkSolver::eLambert)
+			{
+				Link::FindLambertLinks(links, conf);
+			}
+			else Link::FindLinks(links, conf, f0s);
 		}
 		else
 		{
@@ -67,6 +99,21 @@ namespace Pathfinder::Solvers::Utiles
 			conf.RB = asStatic->R;
 			Link::FindLinks(links, conf, f0s);
 		}
+		findLinksCount.Observe(FReal(links.size() - count));
+	}
+
+	namespace
+	{
+		// FlightNode is a node of a flight tree: accumulated values and a link stored in the run's pool
+		struct FlightNode
+		{
+			LinkPool::index link = LinkPool::none;
+			FReal totalCorrection = 0;
+			FReal totalMismatch = 0;
+			FReal totalImpulse = 0;
+			FReal totalTime = 0;
+			FReal absTime = 0;
+		};
 	}
 
 	std::vector<PathFinder::FlightChain> ComputeFlight(
@@ -75,84 +122,195 @@ namespace Pathfinder::Solvers::Utiles
 		, FReal t0
 		, FReal GM
 		, bool bWithCorrection
+		, LegCache* cache
+		, const Pruning* pruning
 	) {
-		using Tree = PathTree<PathFinder::FlightInfo>;
+		auto timer = flightTime.Measure();
+
+		// \note: the tree and the chains keep indices of the pool's links, so a link is never copied
+		// \note: the chains share the pool, so it's alive while any of them is
+		auto  pool = std::make_shared<LinkPool>();
+		using Tree = PathTree<FlightNode>;
 		auto  tree = Tree();
-		tree.RegisterOnAdded([](PathFinder::FlightInfo& parent, PathFinder::FlightInfo& child)
+		tree.RegisterOnAdded([](FlightNode& parent, FlightNode& child)
 		{
 			child.absTime += parent.absTime;
 			child.totalTime += parent.totalTime;
 			child.totalImpulse += parent.totalImpulse;
 			child.totalMismatch += parent.totalMismatch;
 		});
-		auto rootID = tree.AppendPath([&]()->PathFinder::FlightInfo
+		auto rootID = tree.AppendPath([&]()->FlightNode
 		{
-			auto node = PathFinder::FlightInfo();
-			node.link.W1 = FVector(0, 0, 0);
+			auto node = FlightNode();
 			node.absTime = t0;
 			return node;
 		}());
 		
-		auto parents  = std::deque<Tree::pathID>();
-		auto children = std::deque<Tree::pathID>();
+		auto parents  = std::vector<Tree::pathID>();
+		auto children = std::vector<Tree::pathID>();
 		parents.push_back(rootID);
 
-		auto links = std::vector<Link::Link>();
-		Utiles::FillTree(nodes, [&](const NodeA& iA, const NodeA& iB, bool bLast)
-		{	// find all flights from A to B
-			for (; parents.size(); parents.pop_front(), links.clear())
+		using Child = std::pair<FlightNode, Link::Link>;
+
+		// checks whether no completion of the partial flight can get to the best ones
+		// \note: only the accumulated values are passed to the bound; a correction isn't
+		//        accumulated along a flight, so a partial one is bounded with zero correction
+		auto IsPruned = [&](const FlightNode& node)
+		{
+			if (!pruning)
+			{
+				return false;
+			}
+			auto partial = PathFinder::FlightChain();
+			partial.Mismatch = node.totalMismatch;
+			partial.Impulse = node.totalImpulse;
+			partial.totalTime = node.totalTime;
+			partial.startTime = t0;
+			if (pruning->bound(partial) > pruning->incumbent.GetThreshold())
+			{
+				pruning->incumbent.AddPruned();
+				return true;
+			}
+			return false;
+		};
+
+		// finds all flights from the parent to B and stores them in the buffer
+		auto ExpandParent = [&](const FlightNode& parent, const NodeA& iA, const NodeA& iB, bool bLast, std::vector<Child>& buffer)
+		{
+			if (IsPruned(parent))
+			{
+				return;
+			}
+
+			// find all links from the departure time
+			auto links = std::vector<Link::Link>();
+			if (cache)
 			{
-				const auto  parentID = parents.front();
-				const auto& parent = tree.GetPathByIF(parentID);
-				
-				// find all links from the departure time
-				Utiles::FindLinks(links, iA.node, iB.node, mission, iA.f0s, parent.absTime, GM);
-				
-				// create child nodes
-				for (auto& link : links)
+				cache->GetLinks(links, iA.node.get(), iB.node.get(), iA.f0s, parent.absTime, [&](auto& solved, FReal t0)
 				{
-					auto child = PathFinder::FlightInfo();
-					{ // check out node
-						auto params = Nodes::INode::InParams{ parent.link.W1, link.W0 };
-						auto [res, bOK] = iA.node->Check(params, bWithCorrection);
-						if (!bOK)
-						{
-							continue;
-						}
-						child.totalCorrection += res.Correction;
-						child.totalMismatch += res.Mismatch;
-						child.totalImpulse += res.Impulse;
+					Utiles::FindLinks(solved, iA.node, iB.node, mission, iA.f0s, t0, GM);
+				});
+			}
+			else Utiles::FindLinks(links, iA.node, iB.node, mission, iA.f0s, parent.absTime, GM);
+
+			// create child nodes
+			auto W1 = parent.link != LinkPool::none ? pool->Get(parent.link).W1 : FVector(0, 0, 0);
+			for (auto& link : links)
+			{
+				auto child = FlightNode();
+				{ // check out node
+					auto params = Nodes::INode::InParams{ W1, link.W0 };
+					auto [res, bOK] = iA.node->Check(params, bWithCorrection);
+					CountCheck(bOK);
+					if (!bOK)
+					{
+						continue;
 					}
-					if (bLast)
-					{ // check in node
-						auto params = Nodes::INode::InParams{ link.W1, FVector(0) };
-						auto [res, bOK] = iB.node->Check(params, bWithCorrection);
-						if (!bOK)
-						{
-							continue;
-						}
-						child.totalCorrection += res.Correction;
-						child.totalMismatch += res.Mismatch;
-						child.totalImpulse += res.Impulse;
+					child.totalCorrection += res.Correction;
+					child.totalMismatch += res.Mismatch;
+					child.totalImpulse += res.Impulse;
+				}
+				if (bLast)
+				{ // check in node
+					auto params = Nodes::INode::InParams{ link.W1, FVector(0) };
+					auto [res, bOK] = iB.node->Check(params, bWithCorrection);
+					CountCheck(bOK);
+					if (!bOK)
+					{
+						continue;
 					}
-					child.link = link;
-					child.absTime = link.dt;
-					child.totalTime = link.dt;
-					children.push_back(tree.AppendPath(child, parentID));
+					child.totalCorrection += res.Correction;
+					child.totalMismatch += res.Mismatch;
+					child.totalImpulse += res.Impulse;
+				}
+				child.absTime = link.dt;
+				child.totalTime = link.dt;
+				buffer.emplace_back(child, std::move(link));
+			}
+		};
+
+		Utiles::FillTree(nodes, [&](const NodeA& iA, const NodeA& iB, bool bLast)
+		{	// expand the whole level in parallel
+			// \note: the tree and the pool are only read here, so the parents can be accessed concurrently
+			auto buffers = std::vector<std::vector<Child>>(parents.size());
+			Parallel::For(parents.size(), mission.threads, [&](size_t i)
+			{
+				const auto& parent = std::as_const(tree).GetPathByIF(parents[i]);
+				ExpandParent(parent, iA, iB, bLast, buffers[i]);
+			});
+
+			// splice the buffers in the parents' order to keep IDs reproducible
+			auto count = size_t(0);
+			for (auto& buffer : buffers)
+			{
+				count += buffer.size();
+			}
+			pool->Reserve(count);
+			tree.Reserve(count);
+
+			children.clear();
+			for (size_t i = 0; i < parents.size(); ++i)
+			{
+				for (auto& [child, link] : buffers[i])
+				{
+					child.link = pool->Add(std::move(link));
+					children.push_back(tree.AppendPath(child, parents[i]));
 				}
 			}
 			std::swap(parents, children);
 		});
 
+		// materialise the chains reached the last node
 		auto paths = std::vector<PathFinder::FlightChain>();
-		for (auto& path : tree.GetFullPathByID(parents, true))
+		paths.reserve(parents.size());
+		for (auto parent : parents)
 		{
+			auto path = tree.GetFullPathByID(parent, true);
 			if (!path.size())
 			{
 				continue;
 			}
-			paths.emplace_back(std::move(path));
+
+			auto chain = std::vector<PathFinder::FlightLeg>(path.size());
+			for (size_t i = 0; i < path.size(); ++i)
+			{
+				auto& leg = chain[i];
+				leg.totalCorrection = path[i].totalCorrection;
+				leg.totalMismatch = path[i].totalMismatch;
+				leg.totalImpulse = path[i].totalImpulse;
+				leg.totalTime = path[i].totalTime;
+				leg.absTime = path[i].absTime;
+				leg.link = path[i].link;
+			}
+			paths.emplace_back(std::move(chain), pool);
+		}
+
+		if (pruning)
+		{	// offer the complete flights first, so the date's own best ones tighten the threshold
+			auto values = std::vector<FReal>();
+			values.reserve(paths.size());
+			for (auto& path : paths)
+			{
+				pruning->incumbent.Offer(values.emplace_back(pruning->functionality(path)));
+			}
+
+			auto threshold = pruning->incumbent.GetThreshold();
+			auto kept = size_t(0);
+			for (size_t i = 0; i < paths.size(); ++i)
+			{
+				if (!(values[i] > threshold))
+				{
+					if (kept != i)
+					{
+						paths[kept] = std::move(paths[i]);
+					}
+					++kept;
+				}
+			}
+			pruning->incumbent.AddPruned(paths.size() - kept);
+			paths.resize(kept);
 		}
+		flightCount.Observe(FReal(paths.size()));
 		return paths;
 	}
 }
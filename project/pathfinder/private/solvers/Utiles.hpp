@@ -8,6 +8,13 @@
 
 
 
+namespace Pathfinder::Solvers
+{
+	class LegCache;
+	class Incumbent;
+}
+
+
 namespace Pathfinder::Solvers::Utiles
 {
 	FReal GetFlyTimeLimit(FReal r0, FReal r1, FReal factor, FReal GM);
@@ -19,11 +26,14 @@ namespace Pathfinder::Solvers::Utiles
 		, const Nodes::INode::ptr& A     // node to get out
 		, const Nodes::INode::ptr& B     // node to get to
 		, const MissionConfig& mission   // mission settings
-		, const std::vector<FReal>& f0s  // toss angles
+		, const std::vector<FReal>& f0s  // toss angles (Lambert legs to scripted nodes don't use them)
 		, FReal t0                       // departure time
 		, FReal GM						 // center body's gravity parameter
 	);
 
+	// counts a node's check in "INode.Check" metrics
+	void CountCheck(bool bOK);
+
 	template<typename It, typename Fn>
 	void FillTree(It bgn, It end, Fn clb)
 	{
@@ -47,12 +57,22 @@ namespace Pathfinder::Solvers::Utiles
 		const std::vector<FReal>& f0s;
 	};
 
+	// Pruning cuts partial flights which cannot get to the K best complete ones
+	struct Pruning
+	{
+		const PathFinder::Functionality& functionality; // maps complete flights
+		const PathFinder::Functionality& bound;         // maps partial flights to lower bounds of their completions (see PathFinder::SetPartialBound)
+		Incumbent& incumbent;                           // K best values of complete flights
+	};
+
 	std::vector<PathFinder::FlightChain> ComputeFlight(
 		  const MissionConfig& mission
 		, const std::vector<NodeA>& nodes
 		, FReal t0
 		, FReal GM
 		, bool bWithCorrection = false
+		, LegCache* cache = nullptr      // memoised legs (nullptr - no memoisation)
+		, const Pruning* pruning = nullptr // branch and bound settings (nullptr - all the flights are expanded)
 	);
 }
 
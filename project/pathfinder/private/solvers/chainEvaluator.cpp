@@ -0,0 +1,93 @@
+#include "solvers/chainEvaluator.hpp"
+
+
+
+namespace Pathfinder::Solvers::Utiles
+{
+	ChainEvaluator::ChainEvaluator(const MissionConfig& mission, const std::vector<NodeA>& nodes, FReal GM, bool bWithCorrection)
+		: mission(mission)
+		, nodes(nodes)
+		, GM(GM)
+		, bWithCorrection(bWithCorrection)
+		, legs(nodes.size() > 1 ? nodes.size() - 1 : 0)
+	{}
+
+	FReal ChainEvaluator::Evaluate(FReal t0, const PathFinder::Functionality& functionality_)
+	{
+		best = NAN;
+		if (legs.empty())
+		{
+			return best;
+		}
+
+		functionality = &functionality_;
+		flight.startTime = t0;
+
+		auto root = Totals();
+		root.absTime = t0;
+		Walk(0, root, FVector(0, 0, 0));
+		return best;
+	}
+
+	void ChainEvaluator::Walk(size_t leg, const Totals& parent, const FVector& W1)
+	{
+		auto& iA = nodes[leg + 0];
+		auto& iB = nodes[leg + 1];
+		auto bLast = leg + 1 == legs.size();
+
+		// \note: the deeper legs use their own buffers, so the links stay valid during the walk
+		auto& links = legs[leg];
+		links.clear();
+		Utiles::FindLinks(links, iA.node, iB.node, mission, iA.f0s, parent.absTime, GM);
+
+		for (auto& link : links)
+		{
+			auto child = Totals();
+			{ // check out node
+				auto params = Nodes::INode::InParams{ W1, link.W0 };
+				auto [res, bOK] = iA.node->Check(params, bWithCorrection);
+				CountCheck(bOK);
+				if (!bOK)
+				{
+					continue;
+				}
+				child.correction += res.Correction;
+				child.mismatch += res.Mismatch;
+				child.impulse += res.Impulse;
+			}
+			if (bLast)
+			{ // check in node
+				auto params = Nodes::INode::InParams{ link.W1, FVector(0) };
+				auto [res, bOK] = iB.node->Check(params, bWithCorrection);
+				CountCheck(bOK);
+				if (!bOK)
+				{
+					continue;
+				}
+				child.correction += res.Correction;
+				child.mismatch += res.Mismatch;
+				child.impulse += res.Impulse;
+			}
+			child.absTime = link.dt + parent.absTime;
+			child.time = link.dt + parent.time;
+			child.impulse += parent.impulse;
+			child.mismatch += parent.mismatch;
+
+			if (!bLast)
+			{
+				Walk(leg + 1, child, link.W1);
+				continue;
+			}
+
+			flight.Correction = child.correction;
+			flight.Mismatch = child.mismatch;
+			flight.Impulse = child.impulse;
+			flight.totalTime = child.time;
+			auto value = (*functionality)(flight);
+			if (value < best || isnan(best))
+			{
+				best = value;
+			}
+		}
+	}
+}
@@ -0,0 +1,52 @@
+#ifndef PATHFINDER__CHAINEVALUATOR_HPP
+#define PATHFINDER__CHAINEVALUATOR_HPP
+
+#include <boost/noncopyable.hpp>
+#include "solvers/Utiles.hpp"
+
+
+
+namespace Pathfinder::Solvers::Utiles
+{
+	// ChainEvaluator computes the best functionality of flights along a fixed chain of nodes
+	// \note:	the flights are the ones ComputeFlight finds, but they are walked depth first with link 
+	//			buffers kept between the calls, and no tree or chain is built: the functionality gets 
+	//			flights with totals only (FlightChain::chain is empty)
+	// \note:	the toss angles of the nodes are read on every call, so they can change between the calls
+	class ChainEvaluator final : boost::noncopyable
+	{
+	public:
+		ChainEvaluator(const MissionConfig& mission, const std::vector<NodeA>& nodes, FReal GM, bool bWithCorrection = false);
+
+		// returns the least functionality of the flights departing at t0 (NAN - there are no flights)
+		// \note: the least value is the first one ComputeFlight's flights give
+		FReal Evaluate(FReal t0, const PathFinder::Functionality& functionality);
+
+	private:
+		// accumulated values of a partial flight (as ComputeFlight accumulates them)
+		struct Totals
+		{
+			FReal correction = 0; // \note: the correction of the last leg only
+			FReal mismatch = 0;
+			FReal impulse = 0;
+			FReal time = 0;
+			FReal absTime = 0;
+		};
+
+		void Walk(size_t leg, const Totals& parent, const FVector& W1);
+
+	private:
+		const MissionConfig& mission;
+		const std::vector<NodeA>& nodes;
+		const FReal GM;
+		const bool bWithCorrection;
+
+		std::vector<std::vector<Link::Link>> legs; // links of the legs being walked
+		PathFinder::FlightChain flight;            // totals of the complete flight being mapped
+		const PathFinder::Functionality* functionality = nullptr;
+		FReal best = NAN;
+	};
+}
+
+
+#endif //!PATHFINDER__CHAINEVALUATOR_HPP
@@ -0,0 +1,51 @@
+#include "solvers/incumbent.hpp"
+#include <limits>
+
+
+
+namespace Pathfinder::Solvers
+{
+	Incumbent::Incumbent(size_t K)
+		: K(K)
+		, threshold(std::numeric_limits<FReal>::infinity())
+	{
+		if (K == 0)
+		{
+			throw std::runtime_error("incumbent must keep at least one value");
+		}
+	}
+
+	FReal Incumbent::GetThreshold() const
+	{
+		return threshold.load(std::memory_order_relaxed);
+	}
+
+	void Incumbent::Offer(FReal value)
+	{
+		if (isnan(value) || !(value < GetThreshold()))
+		{
+			return;
+		}
+
+		auto lock = std::lock_guard(mutex);
+		best.push(value);
+		if (best.size() > K)
+		{
+			best.pop();
+		}
+		if (best.size() == K)
+		{
+			threshold.store(best.top(), std::memory_order_relaxed);
+		}
+	}
+
+	void Incumbent::AddPruned(UInt64 count)
+	{
+		pruned.fetch_add(count, std::memory_order_relaxed);
+	}
+
+	UInt64 Incumbent::GetPruned() const
+	{
+		return pruned.load(std::memory_order_relaxed);
+	}
+}
@@ -0,0 +1,41 @@
+#ifndef PATHFINDER__INCUMBENT_HPP
+#define PATHFINDER__INCUMBENT_HPP
+
+#include <boost/noncopyable.hpp>
+#include "math/math.hpp"
+#include <atomic>
+#include <mutex>
+#include <queue>
+
+
+
+namespace Pathfinder::Solvers
+{
+	// Incumbent keeps the K best (least) functionality values of complete flights found so far
+	// \note: the K-th best value is a threshold: a partial flight whose lower bound exceeds it cannot get to the K best
+	// \note: the incumbent is thread safe; the threshold is read without locks
+	class Incumbent final : boost::noncopyable
+	{
+	public:
+		Incumbent(size_t K);
+
+		// returns the K-th best value (+inf until K values are offered)
+		FReal GetThreshold() const;
+
+		void Offer(FReal value);
+
+		// counts flights pruned against the threshold
+		void AddPruned(UInt64 count = 1);
+		UInt64 GetPruned() const;
+
+	private:
+		const size_t K;
+		std::mutex mutex;
+		std::priority_queue<FReal> best;
+		std::atomic<FReal>  threshold;
+		std::atomic<UInt64> pruned = 0;
+	};
+}
+
+
+#endif //!PATHFINDER__INCUMBENT_HPP
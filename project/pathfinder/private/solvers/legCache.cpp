@@ -0,0 +1,130 @@
+#include "solvers/legCache.hpp"
+
+
+
+namespace Pathfinder::Solvers::Utiles
+{
+	template<typename T>
+	void HashCombine(size_t& seed, const T& value)
+	{
+		seed ^= std::hash<T>()(value) + 0x9e3779b9 + (seed << 6) + (seed >> 2);
+	}
+
+	size_t HashRange(const std::vector<FReal>& values)
+	{
+		auto seed = values.size();
+		for (auto value : values)
+		{
+			HashCombine(seed, value);
+		}
+		return seed;
+	}
+}
+
+
+namespace Pathfinder::Solvers
+{
+	bool LegCache::Key::operator==(const Key& rhs) const
+	{
+		return A == rhs.A
+			&& B == rhs.B
+			&& block == rhs.block
+			&& f0sHash == rhs.f0sHash
+			&& *f0s == *rhs.f0s;
+	}
+
+	size_t LegCache::KeyHash::operator()(const Key& key) const
+	{
+		auto seed = size_t(0);
+		Utiles::HashCombine(seed, key.A);
+		Utiles::HashCombine(seed, key.B);
+		Utiles::HashCombine(seed, key.block);
+		Utiles::HashCombine(seed, key.f0sHash);
+		return seed;
+	}
+
+
+	LegCache::LegCache(FReal timeFrac, size_t memoryLimit)
+		: timeFrac(timeFrac)
+		, memoryLimit(memoryLimit)
+	{
+		if (!(timeFrac > 0))
+		{
+			throw std::runtime_error("leg cache requires a positive time fraction");
+		}
+	}
+
+	void LegCache::GetLinks(Links& links, const Nodes::INode* A, const Nodes::INode* B, const std::vector<FReal>& f0s, FReal t0, const Solve& solve)
+	{
+		auto key = Key{ A, B, Int64(std::floor(t0 / timeFrac)), Utiles::HashRange(f0s), &f0s };
+		auto tb  = (key.block + FReal(0.5)) * timeFrac;
+
+		auto& shard = shards[KeyHash()(key) % shardsCount];
+		auto  leg   = std::shared_ptr<const Links>();
+		{
+			auto lock = std::lock_guard(shard.mutex);
+			if (auto pos = shard.legs.find(key); pos != shard.legs.end())
+			{
+				leg = pos->second.links;
+			}
+		}
+
+		if (leg)
+		{
+			++hits;
+		}
+		else
+		{	// \note: concurrent misses of the same leg solve it at the same time, so any of them can be kept
+			++misses;
+			auto solved = std::make_shared<Links>();
+			solve(*solved, tb);
+			leg = solved;
+
+			auto size = sizeof(Key) + sizeof(Leg) + f0s.size() * sizeof(FReal) + sizeof(Links) + solved->capacity() * sizeof(Link::Link);
+			if (Reserve(size))
+			{
+				auto copy = std::make_unique<const std::vector<FReal>>(f0s);
+				key.f0s = copy.get();
+
+				auto lock = std::lock_guard(shard.mutex);
+				if (shard.legs.emplace(key, Leg{ std::move(copy), solved }).second)
+				{
+					++entries;
+				}
+				else bytes -= size;
+			}
+			else ++refused;
+		}
+
+		for (auto& link : *leg)
+		{
+			auto& copy = links.emplace_back(link);
+			copy.t0 = t0;
+			copy.t1 = t0 + copy.dt;
+		}
+	}
+
+	bool LegCache::Reserve(size_t size)
+	{
+		auto current = bytes.load(std::memory_order_relaxed);
+		do
+		{
+			if (current + size > memoryLimit)
+			{
+				return false;
+			}
+		} while (!bytes.compare_exchange_weak(current, current + size, std::memory_order_relaxed));
+		return true;
+	}
+
+	auto LegCache::GetStats() const -> Stats
+	{
+		auto stats = Stats();
+		stats.hits    = hits;
+		stats.misses  = misses;
+		stats.entries = entries;
+		stats.refused = refused;
+		stats.bytes   = bytes;
+		return stats;
+	}
+}
@@ -0,0 +1,84 @@
+#ifndef PATHFINDER__LEGCACHE_HPP
+#define PATHFINDER__LEGCACHE_HPP
+
+#include <boost/noncopyable.hpp>
+#include "pathfinder.hpp"
+#include <unordered_map>
+#include <atomic>
+#include <array>
+#include <mutex>
+
+
+
+namespace Pathfinder::Solvers
+{
+	// LegCache memoises links of legs across the departure times of one run
+	// \note: a leg is solved once per time block (floor(t0 / timeFrac)) at the block's middle time,
+	//        and the links are shifted to the requested departure time; so the links don't depend
+	//        on an order the departure times are requested in (flight times are kept, arrival times are shifted)
+	// \note: the departure body's state must be the same inside of the block, so the cache requires
+	//        discrete ephemerides of timeFrac step; the links differ from directly found ones less than the step does
+	// \note: the cache is thread safe; new legs are refused when the memory cap is reached
+	class LegCache final : boost::noncopyable
+	{
+	public:
+		using Links = std::vector<Link::Link>;
+		using Solve = std::function<void(Links& links, FReal t0)>;
+		using Stats = PathFinder::LegCacheStats;
+
+	public:
+		LegCache(FReal timeFrac, size_t memoryLimit);
+
+		// appends links of the leg A -> B departing at t0 calling solve() on a miss
+		void GetLinks(Links& links, const Nodes::INode* A, const Nodes::INode* B, const std::vector<FReal>& f0s, FReal t0, const Solve& solve);
+
+		auto GetStats() const->Stats;
+
+	private:
+		struct Key
+		{
+			const Nodes::INode* A = nullptr;
+			const Nodes::INode* B = nullptr;
+			Int64  block = 0;
+			size_t f0sHash = 0;
+			const std::vector<FReal>* f0s = nullptr; // \note: a view of the requested angles or of the leg's own copy
+
+			bool operator==(const Key& rhs) const;
+		};
+
+		struct Leg
+		{
+			std::unique_ptr<const std::vector<FReal>> f0s; // the angles the leg's key views
+			std::shared_ptr<const Links> links;
+		};
+
+		struct KeyHash
+		{
+			size_t operator()(const Key& key) const;
+		};
+
+		struct Shard
+		{
+			std::mutex mutex;
+			std::unordered_map<Key, Leg, KeyHash> legs;
+		};
+
+		static constexpr size_t shardsCount = 32;
+
+		bool Reserve(size_t size);
+
+	private:
+		FReal  timeFrac = 0;
+		size_t memoryLimit = 0;
+		std::array<Shard, shardsCount> shards;
+
+		std::atomic<size_t> bytes   = 0;
+		std::atomic<UInt64> hits    = 0;
+		std::atomic<UInt64> misses  = 0;
+		std::atomic<UInt64> entries = 0;
+		std::atomic<UInt64> refused = 0;
+	};
+}
+
+
+#endif //!PATHFINDER__LEGCACHE_HPP
@@ -0,0 +1,52 @@
+#ifndef PATHFINDER__LINKPOOL_HPP
+#define PATHFINDER__LINKPOOL_HPP
+
+#include <boost/noncopyable.hpp>
+#include "links.hpp"
+
+
+
+namespace Pathfinder::Solvers
+{
+	// LinkPool is an arena of links
+	// \note: each link is stored once, and a run's nodes and flight chains refer to it with a compact index
+	// \note: the pool isn't thread safe: links are added by one thread and may be read concurrently between additions
+	class LinkPool final : boost::noncopyable
+	{
+	public:
+		using index = UInt32;
+		static constexpr index none = ~index(0);
+
+	public:
+		void Reserve(size_t count)
+		{
+			links.reserve(links.size() + count);
+		}
+
+		index Add(Link::Link&& link)
+		{
+			if (links.size() >= size_t(none))
+			{
+				throw std::runtime_error("the link pool is overflowed");
+			}
+			links.emplace_back(std::move(link));
+			return index(links.size() - 1);
+		}
+
+		const Link::Link& Get(index i) const
+		{
+			return links.at(i);
+		}
+
+		size_t GetCount() const
+		{
+			return links.size();
+		}
+
+	private:
+		std::vector<Link::Link> links;
+	};
+}
+
+
+#endif //!PATHFINDER__LINKPOOL_HPP
@@ -7,44 +7,13 @@
 
 namespace Pathfinder
 {
+	// PathTree stores paths sharing their beginnings
+	// \note: nodes live in one contiguous vector: a path's ID is its node's index + rootID,
+	//        and nodes refer to their parents by IDs; so appends are amortised O(1),
+	//        lookups are direct, and the whole tree is released at once
 	template<typename T>
 	class PathTree final : boost::noncopyable
 	{
-		struct Node : boost::noncopyable
-		{
-			using ptr = std::unique_ptr<Node>;
-			
-			int lvl = 0;
-			Node* parent = nullptr;
-			std::vector<ptr> children;
-			T payload;
-
-		public:
-			static ptr New()
-			{
-				return std::make_unique<Node>();
-			}
-
-			Node() = default;
-
-			Node(const T& payload)
-				: payload(payload)
-			{}
-
-			Node* NewChild(const T& childData)
-			{
-				auto child   = New();
-				auto pointer = &*child;
-
-				child->lvl     = lvl + 1;
-				child->parent  = this;
-				child->payload = childData;
-				
-				children.emplace_back(std::move(child));
-				return pointer;
-			}
-		};
-
 	public:
 
 		enum EFillInFlag
@@ -56,14 +25,23 @@ namespace Pathfinder
 		using pathID   = uint64_t;
 		using FOnAdded = std::function<void(T& parent, T& child)>;
 
+	private:
+
+		struct Node
+		{
+			pathID parent = 0;
+			int lvl = 0;
+			T payload;
+		};
+
 	public: // << interface functions
 
 		static constexpr pathID rootID = 1;
 
 
-		PathTree() : root(Node::New())
+		PathTree()
 		{
-			ID2Node[rootID] = &*root;
+			nodes.emplace_back();
 		}
 
 		void RegisterOnAdded(FOnAdded callback)
@@ -71,35 +49,47 @@ namespace Pathfinder
 			onAdded = callback;
 		}
 
+		// reserves space for count more paths
+		void Reserve(size_t count)
+		{
+			nodes.reserve(nodes.size() + count);
+		}
+
+		size_t GetSize() const
+		{
+			return nodes.size();
+		}
+
 		pathID AppendPath(const T& nextLink, pathID path = rootID)
 		{
-			auto parent  = GetNodeChecked(path);
-			auto child   = parent->NewChild(nextLink);
-			auto childID = NextID();
-			ID2Node[childID] = child;
+			auto lvl     = GetNodeChecked(path).lvl + 1;
+			auto childID = ToID(nodes.size());
+			nodes.push_back({ path, lvl, nextLink });
+
+			// \note: the parent is taken after the push, since the push may move the nodes
 			if (onAdded && path != rootID)
 			{
-				onAdded(parent->payload, child->payload);
+				onAdded(GetNode(path).payload, nodes.back().payload);
 			}
 			return childID;
 		}
 
-		auto GetFullPathByID(pathID path, bool bNoFirst = false)->std::vector<T>
+		auto GetFullPathByID(pathID path, bool bNoFirst = false) const->std::vector<T>
 		{
 			auto offset = bNoFirst ? 1 : 0;
-			auto leaf = GetNodeChecked(path);
+			auto leaf = &GetNodeChecked(path);
 			auto size = leaf->lvl - offset;
-			auto list = std::vector<T>(size);
+			auto list = std::vector<T>(size > 0 ? size : 0);
 			for (auto i = size - 1; i >= 0; --i)
 			{
 				list[i] = leaf->payload;
-				leaf    = leaf->parent;
+				leaf    = &GetNode(leaf->parent);
 			}
 			return list;
 		}
 
 		template<typename C>
-		auto GetFullPathByID(const C& paths, bool bNoFirst = false)->std::vector<std::vector<T>>
+		auto GetFullPathByID(const C& paths, bool bNoFirst = false) const->std::vector<std::vector<T>>
 		{
 			auto lists = std::vector<std::vector<T>>();
 			lists.reserve(paths.size());
@@ -112,57 +102,49 @@ namespace Pathfinder
 
 		T& GetPathByIF(pathID path)
 		{
-			return GetNodeChecked(path)->payload;
+			return GetNodeChecked(path).payload;
 		}
 
 		const T& GetPathByIF(pathID path) const
 		{ CONST_FUNCTION_ENTERY(GetPathByIF(path)); }
 
 	private: // << internal functions
-		
-		Node* GetNodeChecked(pathID id)
+
+		static pathID ToID(size_t index)
 		{
-			__func__;
-			auto node = GetNode(id);
-			CheckNodeFromID(node, id);
-			return node;
+			return pathID(index) + rootID;
 		}
 
-		const Node* GetNodeChecked(pathID id) const
-		{ CONST_FUNCTION_ENTERY(GetNodeChecked(id)); }
-
-		Node* GetNode(pathID id)
+		static size_t ToIndex(pathID id)
 		{
-			auto itr = ID2Node.find(id);
-			auto end = ID2Node.end();
-			return itr != end ? itr->second : nullptr;
+			return size_t(id - rootID);
 		}
-
-		const Node* GetNode(pathID id) const
-		{ CONST_FUNCTION_ENTERY(GetNode(id)); }
-
-		void CheckNodeFromID(const Node* node, pathID id) const
+		
+		Node& GetNodeChecked(pathID id)
 		{
-			if (!node)
+			if (id < rootID || ToIndex(id) >= nodes.size())
 			{
 				throw std::runtime_error("the path doesn't exists in the tree: " + std::to_string(id));
 			}
+			return GetNode(id);
 		}
 
-		pathID NextID()
+		const Node& GetNodeChecked(pathID id) const
+		{ CONST_FUNCTION_ENTERY(GetNodeChecked(id)); }
+
+		Node& GetNode(pathID id)
 		{
-			return ++IDcounter;
+			return nodes[ToIndex(id)];
 		}
 
-	private:
+		const Node& GetNode(pathID id) const
+		{ CONST_FUNCTION_ENTERY(GetNode(id)); }
 
-		typename Node::ptr root;
+	private:
 
-		typename FOnAdded onAdded;
-		
-		typename pathID IDcounter = rootID;
+		std::vector<Node> nodes;
 
-		std::map<pathID, Node*> ID2Node;
+		FOnAdded onAdded;
 	};
 }
 
@@ -0,0 +1,143 @@
+#include "porkchop.hpp"
+#include "solvers/porkchopScan.hpp"
+#include "solvers/Utiles.hpp"
+#include "blocks/link.hpp"
+#include "parallel.hpp"
+
+
+
+namespace Pathfinder::Porkchop::Utiles
+{
+	std::vector<FReal> MakeAxis(FReal min, FReal max, FReal step, const std::string& name)
+	{
+		if (isnan(min) || isnan(max) || !(step > 0) || min > max)
+		{
+			throw std::runtime_error("porkchop's " + name + " range is invalid");
+		}
+
+		auto axis = std::vector<FReal>();
+		for (size_t i = 0; min + step * i <= max; ++i)
+		{
+			axis.push_back(min + step * i);
+		}
+		return axis;
+	}
+
+	// returns a flight time mismatch (dt - tof) of the static link or NAN if there is no link
+	FReal GetMismatch(const Link::StaticLinkConfig& cfg, FReal f0, FReal tof, Link::Utiles::StaticLink& link)
+	{
+		link = Link::Utiles::StaticLink(cfg, f0);
+		return link.Find_t() ? link.dt - tof : NAN;
+	}
+
+	// finds a toss angle with the required flight time inside of a sign change of the mismatch
+	// \note: the mismatch jumps on orbit type changes, so the found root is checked by the tolerance
+	bool FindRoot(const Link::StaticLinkConfig& cfg, FReal tof, FReal tol, FReal fa, FReal va, FReal fb, Link::Utiles::StaticLink& link)
+	{
+		for (auto iter = 0; iter < 64; ++iter)
+		{
+			auto fm = Math::Avg(fa, fb);
+			auto vm = GetMismatch(cfg, fm, tof, link);
+			if (isnan(vm))
+			{
+				return false;
+			}
+			if (Math::Abs(vm) <= tol)
+			{
+				return true;
+			}
+			if (Math::Sign(vm) == Math::Sign(va))
+			{
+				fa = fm; va = vm;
+			}
+			else fb = fm;
+		}
+		return false;
+	}
+}
+
+
+namespace Pathfinder::Porkchop
+{
+	Porkchop::Porkchop(const PorkchopConfig& config)
+		: conf(config)
+	{
+		if (!conf.A || !conf.B)
+		{
+			throw std::runtime_error("porkchop's bodies must be set");
+		}
+		if (!(conf.GM > 0) || !(conf.timeTol > 0) || !(conf.points_f0 >= 2))
+		{
+			throw std::runtime_error("porkchop's GM, time tolerance and toss angles' count must be positive");
+		}
+		departures  = Utiles::MakeAxis(conf.t0  , conf.t1  , conf.dt  , "departure");
+		flightTimes = Utiles::MakeAxis(conf.tof0, conf.tof1, conf.dtof, "flight time");
+		f0s = Solvers::Utiles::MakeRange(0, 2 * Math::Pi, conf.points_f0);
+	}
+
+	const std::vector<FReal>& Porkchop::GetDepartures() const
+	{
+		return departures;
+	}
+
+	const std::vector<FReal>& Porkchop::GetFlightTimes() const
+	{
+		return flightTimes;
+	}
+
+	void Porkchop::Compute(const OnRow& onRow) const
+	{
+		// \note: rows are evaluated by blocks to keep the memory bounded by the block's size
+		auto workers = Parallel::GetWorkersCount(conf.threads);
+		auto block   = std::vector<std::vector<Cell>>(std::min(departures.size(), workers * 4));
+		for (size_t bgn = 0; bgn < departures.size(); bgn += block.size())
+		{
+			auto count = std::min(block.size(), departures.size() - bgn);
+			Parallel::For(count, workers, [&](size_t i)
+			{
+				ComputeRow(bgn + i, block[i]);
+			});
+			for (size_t i = 0; i < count; ++i)
+			{
+				onRow(bgn + i, block[i]);
+			}
+		}
+	}
+
+	void Porkchop::ComputeRow(size_t row, std::vector<Cell>& cells) const
+	{
+		const auto t0 = departures[row];
+
+		auto cfg = Link::StaticLinkConfig();
+		cfg.GM = conf.GM;
+		cfg.t0 = t0;
+		cfg.SetA(*conf.A);
+
+		cells.assign(flightTimes.size(), Cell());
+		auto link = Link::Utiles::StaticLink(cfg, 0);
+		for (size_t col = 0; col < flightTimes.size(); ++col)
+		{
+			const auto tof = flightTimes[col];
+			std::tie(cfg.RB, cfg.VB) = conf.B->GetMovement(t0 + tof);
+
+			// scan the toss angles for sign changes of the flight time mismatch
+			auto& cell = cells[col];
+			auto  mismatch = [&](FReal f0)
+			{
+				return Utiles::GetMismatch(cfg, f0, tof, link);
+			};
+			Utiles::ScanBrackets(f0s, mismatch, [&](FReal fa, FReal va, FReal fb)
+			{
+				if (Utiles::FindRoot(cfg, tof, conf.timeTol, fa, va, fb, link) && link.FixParams())
+				{
+					auto w0 = link.W0.Size();
+					auto w1 = link.W1.Size();
+					if (isnan(cell.w0) || w0 + w1 < cell.w0 + cell.w1)
+					{
+						cell = { w0, w1, link.f0 };
+					}
+				}
+			});
+		}
+	}
+}
@@ -0,0 +1,36 @@
+#ifndef PATHFINDER__PORKCHOPSCAN_HPP
+#define PATHFINDER__PORKCHOPSCAN_HPP
+
+#include "math/math.hpp"
+#include <vector>
+
+
+
+namespace Pathfinder::Porkchop::Utiles
+{
+	// calls onBracket(fa, va, fb) for each pair of neighbour toss angles the mismatch changes its sign between
+	// \note: the angles cover [0, 2pi) without its end, so the last pair wraps around to (the first angle + 2pi)
+	// \note: a NAN mismatch (no link) brackets nothing
+	template<typename Mismatch, typename OnBracket>
+	void ScanBrackets(const std::vector<FReal>& f0s, Mismatch&& mismatch, OnBracket&& onBracket)
+	{
+		auto fa = f0s.front();
+		auto va = mismatch(fa);
+		const auto v0 = va;
+		for (size_t i = 1; i <= f0s.size(); ++i)
+		{
+			auto bWrap = i == f0s.size();
+			auto fb = bWrap ? f0s.front() + 2 * Math::Pi : f0s[i];
+			auto vb = bWrap ? v0 : mismatch(fb);
+			if (!isnan(va) && !isnan(vb) && Math::Sign(va) != Math::Sign(vb))
+			{
+				onBracket(fa, va, fb);
+			}
+			fa = fb;
+			va = vb;
+		}
+	}
+}
+
+
+#endif //!PATHFINDER__PORKCHOPSCAN_HPP
@@ -0,0 +1,57 @@
+#include "solvers/resultsFilter.hpp"
+#include "solvers/incumbent.hpp"
+#include <limits>
+
+
+
+namespace Pathfinder::Solvers
+{
+	ResultsFilter::ResultsFilter(const PathFinder::OnlineFilter& settings)
+		: settings(settings)
+	{
+		if (settings.topK > 0)
+		{
+			best = std::make_unique<Incumbent>(settings.topK);
+		}
+		if (!isnan(settings.keepFactor) && !(settings.keepFactor > 0 && settings.keepFactor <= 1))
+		{
+			throw std::runtime_error("keep factor of the online filter must be in range of (0, 1]");
+		}
+	}
+
+	ResultsFilter::~ResultsFilter() = default;
+
+	void ResultsFilter::Offer(FReal value)
+	{
+		if (isnan(value))
+		{
+			return;
+		}
+		min = isnan(min) ? value : Math::Min(min, value);
+		max = isnan(max) ? value : Math::Max(max, value);
+		if (best)
+		{
+			best->Offer(value);
+		}
+	}
+
+	FReal ResultsFilter::GetThreshold() const
+	{
+		auto threshold = best ? best->GetThreshold() : std::numeric_limits<FReal>::infinity();
+		if (!isnan(settings.keepFactor) && !isnan(min))
+		{
+			threshold = Math::Min(threshold, min + (max - min) * settings.keepFactor);
+		}
+		return threshold;
+	}
+
+	auto ResultsFilter::GetBounds() const -> std::tuple<FReal, FReal>
+	{
+		return { min, max };
+	}
+
+	const PathFinder::OnlineFilter& ResultsFilter::GetSettings() const
+	{
+		return settings;
+	}
+}
@@ -0,0 +1,41 @@
+#ifndef PATHFINDER__RESULTSFILTER_HPP
+#define PATHFINDER__RESULTSFILTER_HPP
+
+#include <boost/noncopyable.hpp>
+#include "pathfinder.hpp"
+
+
+
+namespace Pathfinder::Solvers
+{
+	class Incumbent;
+
+	// ResultsFilter keeps a threshold of functionality values of FAX flights while they are computed
+	// \note: the threshold is the least of the K-th best value and min + (max - min) * keepFactor
+	//        of all the values offered so far
+	// \note: the filter isn't thread safe
+	class ResultsFilter final : boost::noncopyable
+	{
+	public:
+		ResultsFilter(const PathFinder::OnlineFilter& settings);
+		~ResultsFilter();
+
+		void Offer(FReal value);
+
+		FReal GetThreshold() const;
+
+		// returns bounds of all the values offered so far
+		auto GetBounds() const->std::tuple<FReal, FReal>;
+
+		const PathFinder::OnlineFilter& GetSettings() const;
+
+	private:
+		PathFinder::OnlineFilter settings;
+		std::unique_ptr<Incumbent> best;
+		FReal min = NAN;
+		FReal max = NAN;
+	};
+}
+
+
+#endif //!PATHFINDER__RESULTSFILTER_HPP
@@ -0,0 +1,88 @@
+#include "solvers/seedClusters.hpp"
+#include <algorithm>
+#include <numeric>
+
+
+
+namespace Pathfinder::Solvers
+{
+	namespace
+	{
+		FReal AngleDistance(FReal a, FReal b)
+		{
+			auto d = Math::Abs(a - b);
+			d = d - 2*Math::Pi * std::floor(d / (2*Math::Pi));
+			return Math::Min(d, 2*Math::Pi - d);
+		}
+
+		bool IsNear(const PathFinder::FlightChain& a, const PathFinder::FlightChain& b, FReal timeRadius, FReal angleRadius)
+		{
+			if (a.chain.size() != b.chain.size() || Math::Abs(a.startTime - b.startTime) > timeRadius)
+			{
+				return false;
+			}
+			for (size_t i = 0; i < a.chain.size(); ++i)
+			{
+				auto& la = a.GetLink(i);
+				auto& lb = b.GetLink(i);
+				if (Math::Abs(la.dt - lb.dt) > timeRadius || AngleDistance(la.f0, lb.f0) > angleRadius)
+				{
+					return false;
+				}
+			}
+			return true;
+		}
+	}
+
+	auto ClusterFlights(
+		  const std::vector<const PathFinder::FlightChain*>& flights
+		, const std::vector<FReal>& values
+		, FReal timeRadius
+		, FReal angleRadius
+	) -> std::vector<size_t>
+	{
+		if (flights.size() != values.size())
+		{
+			throw std::runtime_error("each flight to cluster must have a value");
+		}
+		if (!(timeRadius >= 0) || !(angleRadius >= 0))
+		{
+			throw std::runtime_error("clustering radii cannot be negative");
+		}
+
+		auto order = std::vector<size_t>(flights.size());
+		std::iota(order.begin(), order.end(), size_t(0));
+		std::stable_sort(order.begin(), order.end(), [&values](size_t a, size_t b)
+		{
+			return !isnan(values[a]) && (isnan(values[b]) || values[a] < values[b]);
+		});
+
+		// \note: leaders are looked up by start time, so a flight is compared with leaders of near dates only
+		auto rank    = std::vector<size_t>(flights.size());
+		auto leaders = std::vector<size_t>(flights.size());
+		auto byTime  = std::multimap<FReal, size_t>();
+		for (size_t r = 0; r < order.size(); ++r)
+		{
+			auto  i = order[r];
+			auto& flight = *flights[i];
+			rank[i] = r;
+			leaders[i] = i;
+
+			auto pos = byTime.lower_bound(flight.startTime - timeRadius);
+			auto end = byTime.upper_bound(flight.startTime + timeRadius);
+			for (; pos != end; ++pos)
+			{
+				auto leader = pos->second;
+				if ((leaders[i] == i || rank[leader] < rank[leaders[i]]) && IsNear(flight, *flights[leader], timeRadius, angleRadius))
+				{
+					leaders[i] = leader;
+				}
+			}
+			if (leaders[i] == i)
+			{
+				byTime.insert({ flight.startTime, i });
+			}
+		}
+		return leaders;
+	}
+}
@@ -0,0 +1,25 @@
+#ifndef PATHFINDER__SEEDCLUSTERS_HPP
+#define PATHFINDER__SEEDCLUSTERS_HPP
+
+#include "pathfinder.hpp"
+
+
+
+namespace Pathfinder::Solvers
+{
+	// groups near-identical FAX flights, so SAX optimises one flight of a group
+	// \note: flights are near if their start times and legs' flight times differ by at most timeRadius,
+	//        and legs' toss angles (f0) differ by at most angleRadius; flights of different legs count aren't near
+	// \note: flights are visited from the best value to the worst (NAN is the worst), and a flight joins
+	//        the best leader near to it or becomes a leader; so a leader is the best flight of its cluster
+	// returns an index of the leader for each flight (a leader's index is its own)
+	auto ClusterFlights(
+		  const std::vector<const PathFinder::FlightChain*>& flights
+		, const std::vector<FReal>& values
+		, FReal timeRadius
+		, FReal angleRadius
+	) -> std::vector<size_t>;
+}
+
+
+#endif //!PATHFINDER__SEEDCLUSTERS_HPP
@@ -0,0 +1,124 @@
+#ifndef PATHFINDER__CHUNKTABLE_HPP
+#define PATHFINDER__CHUNKTABLE_HPP
+
+#include <boost/noncopyable.hpp>
+#include "math/math.hpp"
+#include <atomic>
+#include <array>
+#include <mutex>
+
+
+
+namespace Pathfinder::PlanetScript
+{
+	// ChunkTable is a concurrent store of lazily filled ephemerides chunks
+	// \note: readers of filled chunks take no locks: a chunk pointer is published
+	//        only when the chunk is completely filled and it's never changed after that
+	// \note: missing chunks are filled exactly once under the table's fill mutex
+	template<typename Chunk>
+	class ChunkTable final : boost::noncopyable
+	{
+		static constexpr size_t pageBits   = 9;
+		static constexpr size_t pageSize   = size_t(1) << pageBits;
+		static constexpr size_t pagesCount = 2048;
+		static constexpr Int64  bias       = Int64(pageSize * pagesCount / 2);
+
+		using Slot = std::atomic<Chunk*>;
+		using Page = std::array<Slot, pageSize>;
+
+	public:
+
+		// max count of chunks on each side of the zero chunk
+		static constexpr Int64 maxChunkN = bias - 1;
+
+		ChunkTable() = default;
+
+		~ChunkTable()
+		{
+			for (auto& page : pages)
+			{
+				auto ptr = page.load(std::memory_order_relaxed);
+				if (!ptr)
+				{
+					continue;
+				}
+				for (auto& slot : *ptr)
+				{
+					delete slot.load(std::memory_order_relaxed);
+				}
+				delete ptr;
+			}
+		}
+
+		// returns a chunk if it was already filled
+		const Chunk* Find(Int64 chunkN) const
+		{
+			auto index = GetIndex(chunkN);
+			auto page  = pages[index >> pageBits].load(std::memory_order_acquire);
+			if (!page)
+			{
+				return nullptr;
+			}
+			return (*page)[index & (pageSize - 1)].load(std::memory_order_acquire);
+		}
+
+		// returns a chunk filling it with fill(chunkN, Chunk&) if it's missing
+		template<typename Fn>
+		const Chunk& GetOrFill(Int64 chunkN, Fn&& fill)
+		{
+			auto& slot = GetSlot(chunkN);
+			if (auto chunk = slot.load(std::memory_order_acquire))
+			{
+				return *chunk;
+			}
+
+			auto lock = std::lock_guard(fillMutex);
+			if (auto chunk = slot.load(std::memory_order_acquire))
+			{
+				return *chunk;
+			}
+
+			auto chunk = std::make_unique<Chunk>();
+			fill(chunkN, *chunk);
+			slot.store(chunk.get(), std::memory_order_release);
+			return *chunk.release();
+		}
+
+	private:
+
+		static size_t GetIndex(Int64 chunkN)
+		{
+			if (chunkN < -maxChunkN || chunkN > maxChunkN)
+			{
+				throw std::out_of_range("chunk is out of the table: " + std::to_string(chunkN));
+			}
+			return size_t(chunkN + bias);
+		}
+
+		Slot& GetSlot(Int64 chunkN)
+		{
+			auto  index = GetIndex(chunkN);
+			auto& entry = pages[index >> pageBits];
+
+			auto page = entry.load(std::memory_order_acquire);
+			if (!page)
+			{
+				auto newPage = new Page{};
+				if (entry.compare_exchange_strong(page, newPage, std::memory_order_acq_rel))
+				{
+					page = newPage;
+				}
+				else delete newPage;
+			}
+			return (*page)[index & (pageSize - 1)];
+		}
+
+	private:
+
+		std::array<std::atomic<Page*>, pagesCount> pages{};
+		std::mutex fillMutex;
+	};
+}
+
+
+#endif //!PATHFINDER__CHUNKTABLE_HPP
@@ -1,27 +1,32 @@
 #include "trajectory/ephemeridesClient.hpp"
+#include "trajectory/ephemerisTable.hpp"
 
 
 
 namespace Pathfinder::Ephemerides
 {
 	EphemeridesClient::EphemeridesClient(IEphemerides* conn)
-		: conn(conn)
+		: conn(nullptr)
 		, time(NAN)
-	{}
+	{
+		SetDriver(conn);
+	}
 
 	EphemeridesClient::EphemeridesClient(IEphemerides::ptr& conn)
-		: conn(&*conn)
-		, time(NAN)
+		: EphemeridesClient(&*conn)
 	{}
 
 	void EphemeridesClient::SetTime(FReal newTime)
 	{
 		time = newTime;
+		row  = table && !isnan(time) ? table->GetRow(time) : -1;
 	}
 
 	void EphemeridesClient::SetDriver(IEphemerides* newConn)
 	{
-		conn = newConn;
+		conn  = newConn;
+		table = conn ? conn->GetTable() : nullptr;
+		SetTime(time);
 	}
 	
 	FReal EphemeridesClient::GetT() const
@@ -44,6 +49,10 @@ namespace Pathfinder::Ephemerides
 	
 	FVector EphemeridesClient::GetLocation() const
 	{
+		if (row >= 0)
+		{
+			return table->GetLocation(row);
+		}
 		if (IsValid())
 		{
 			return conn->GetLocation(time);
@@ -53,6 +62,10 @@ namespace Pathfinder::Ephemerides
 	
 	FVector EphemeridesClient::GetVelocity() const
 	{
+		if (row >= 0)
+		{
+			return table->GetVelocity(row);
+		}
 		if (IsValid())
 		{
 			return conn->GetVelocity(time);
@@ -62,6 +75,10 @@ namespace Pathfinder::Ephemerides
 	
 	auto EphemeridesClient::GetMovement()->std::tuple<FVector, FVector> const
 	{
+		if (row >= 0)
+		{
+			return { table->GetLocation(row), table->GetVelocity(row) };
+		}
 		if (IsValid())
 		{
 			return conn->GetMovement(time);
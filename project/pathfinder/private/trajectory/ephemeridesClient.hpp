@@ -8,6 +8,7 @@
 namespace Pathfinder::Ephemerides
 {
 	// EpehemeridesClient is a default epehemrides db client
+	// \note: if the driver has a flat table the client keeps a cursor to the current time's row
 	class EphemeridesClient final
 	{
 	public:
@@ -28,6 +29,9 @@ namespace Pathfinder::Ephemerides
 	private:
 		IEphemerides* conn;
 		FReal time;
+
+		const EphemerisTable* table = nullptr;
+		Int64 row = -1;
 	};
 }
 
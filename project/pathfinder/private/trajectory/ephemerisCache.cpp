@@ -0,0 +1,265 @@
+#include "ephemerisCache.hpp"
+#include "trajectory/ephemerisTable.hpp"
+#include <boost/interprocess/file_mapping.hpp>
+#include <boost/interprocess/mapped_region.hpp>
+#include <fstream>
+#include <cstring>
+
+
+
+namespace Pathfinder::PlanetScript
+{
+	// file layout:
+	//  - Header
+	//  - Body[header.bodiesCount]
+	//  - columns of each body: EphemerisTable::eColumnsCount arrays of body.count FReals starting at body.offset
+	// \note: the column blocks are aligned to alignment bytes
+
+	struct CacheHeader
+	{
+		char   magic[8];
+		UInt32 version;
+		UInt32 realSize;
+		UInt32 bodiesCount;
+		UInt32 reserved;
+		char   startDate[64];
+	};
+
+	struct EphemerisCache::Body
+	{
+		Int32  planet;
+		UInt32 reserved;
+		FReal  GM;
+		FReal  T;
+		FReal  t0;
+		FReal  stepSize;
+		FReal  chunkSize;
+		Int64  firstBlock;
+		UInt64 count;
+		UInt64 offset;
+	};
+
+	struct EphemerisCache::Data
+	{
+		boost::interprocess::file_mapping  file;
+		boost::interprocess::mapped_region region;
+		const CacheHeader* header = nullptr;
+		const Body* bodies = nullptr;
+	};
+}
+
+
+namespace Pathfinder::PlanetScript::utiles
+{
+	constexpr char   cacheMagic[8] = { 'G', 'A', 'E', 'P', 'H', 'E', 'M', '\0' };
+	constexpr UInt64 cacheAlignment = 64;
+
+	UInt64 Align(UInt64 offset)
+	{
+		return (offset + cacheAlignment - 1) / cacheAlignment * cacheAlignment;
+	}
+}
+
+
+namespace Pathfinder::PlanetScript
+{
+	void EphemerisCache::Build(
+		  const std::string& path
+		, const std::string& J2000Time
+		, const std::vector<EPlanet>& planets
+		, FReal stepSize
+		, FReal chunkSize
+		, FReal tBegin
+		, FReal tEnd
+	) {
+		auto header = CacheHeader();
+		if (J2000Time.size() >= sizeof(header.startDate))
+		{
+			throw std::runtime_error("the start date is too long to be cached: '" + J2000Time + "'");
+		}
+		std::memcpy(header.magic, utiles::cacheMagic, sizeof(header.magic));
+		std::memset(header.startDate, 0, sizeof(header.startDate));
+		std::memcpy(header.startDate, J2000Time.data(), J2000Time.size());
+		header.version = version;
+		header.realSize = sizeof(FReal);
+		header.bodiesCount = UInt32(planets.size());
+		header.reserved = 0;
+
+		auto scripts = std::vector<PlanetScript::ptr>();
+		auto bodies  = std::vector<Body>();
+
+		auto offset = utiles::Align(sizeof(CacheHeader) + sizeof(Body) * planets.size());
+		for (auto planet : planets)
+		{
+			auto& script = *scripts.emplace_back(std::make_shared<PlanetScript>(planet, J2000Time));
+			script.MakeDiscret(stepSize, chunkSize);
+			script.Preload(tBegin, tEnd);
+
+			auto& table = *script.GetTable();
+			auto& body  = bodies.emplace_back();
+			body.planet = Int32(planet);
+			body.reserved = 0;
+			body.GM = script.GetGM(0);
+			body.T  = script.GetT (0);
+			body.t0 = script.GetStartTime();
+			body.stepSize = stepSize;
+			body.chunkSize = chunkSize;
+			body.firstBlock = table.GetFirstBlock();
+			body.count  = table.GetCount();
+			body.offset = offset;
+			offset = utiles::Align(offset + sizeof(FReal) * body.count * Ephemerides::EphemerisTable::eColumnsCount);
+		}
+
+		auto file = std::ofstream(path, std::ios::binary | std::ios::trunc);
+		auto pad  = [&file](UInt64 offset)
+		{
+			static const char zeros[utiles::cacheAlignment] = {};
+			file.write(zeros, offset - UInt64(file.tellp()));
+		};
+		file.write(reinterpret_cast<const char*>(&header), sizeof(header));
+		file.write(reinterpret_cast<const char*>(bodies.data()), sizeof(Body) * bodies.size());
+		for (size_t i = 0; i < bodies.size(); ++i)
+		{
+			pad(bodies[i].offset);
+
+			auto& table = *scripts[i]->GetTable();
+			for (auto column = 0; column < Ephemerides::EphemerisTable::eColumnsCount; ++column)
+			{
+				auto data = table.GetColumn(Ephemerides::EphemerisTable::EColumn(column));
+				file.write(reinterpret_cast<const char*>(data), sizeof(FReal) * table.GetCount());
+			}
+		}
+		if (!file)
+		{
+			throw std::runtime_error("cannot write ephemerides cache: '" + path + "'");
+		}
+	}
+
+	auto EphemerisCache::Open(const std::string& path) -> ptr
+	{
+		namespace bip = boost::interprocess;
+
+		auto data = std::make_shared<Data>();
+		try
+		{
+			data->file   = bip::file_mapping(path.c_str(), bip::read_only);
+			data->region = bip::mapped_region(data->file, bip::read_only);
+		}
+		catch (const bip::interprocess_exception& e)
+		{
+			throw std::runtime_error("cannot map ephemerides cache '" + path + "': " + e.what());
+		}
+
+		auto begin = static_cast<const char*>(data->region.get_address());
+		auto size  = UInt64(data->region.get_size());
+		auto error = [&path](const std::string& reason)
+		{
+			return std::runtime_error("invalid ephemerides cache '" + path + "': " + reason);
+		};
+
+		if (size < sizeof(CacheHeader))
+		{
+			throw error("the file is too short");
+		}
+		data->header = reinterpret_cast<const CacheHeader*>(begin);
+		if (std::memcmp(data->header->magic, utiles::cacheMagic, sizeof(utiles::cacheMagic)) != 0)
+		{
+			throw error("unknown file format");
+		}
+		if (data->header->version != version)
+		{
+			throw error("unsupported version " + std::to_string(data->header->version));
+		}
+		if (data->header->realSize != sizeof(FReal))
+		{
+			throw error("unsupported real size " + std::to_string(data->header->realSize));
+		}
+		if (data->header->startDate[sizeof(data->header->startDate) - 1] != '\0')
+		{
+			throw error("the start date is corrupted");
+		}
+
+		auto bodiesSize = sizeof(Body) * UInt64(data->header->bodiesCount);
+		if (size - sizeof(CacheHeader) < bodiesSize)
+		{
+			throw error("the bodies' records are truncated");
+		}
+		data->bodies = reinterpret_cast<const Body*>(begin + sizeof(CacheHeader));
+		for (UInt32 i = 0; i < data->header->bodiesCount; ++i)
+		{
+			auto& body = data->bodies[i];
+			auto  columnsSize = sizeof(FReal) * body.count * Ephemerides::EphemerisTable::eColumnsCount;
+			if (body.offset % alignof(FReal) != 0
+			 || body.offset > size
+			 || body.count > size / (sizeof(FReal) * Ephemerides::EphemerisTable::eColumnsCount)
+			 || size - body.offset < columnsSize
+			) {
+				throw error("the columns of the body " + std::to_string(body.planet) + " are out of the file");
+			}
+		}
+		return ptr(new EphemerisCache(std::move(data)));
+	}
+
+	EphemerisCache::EphemerisCache(std::shared_ptr<const Data> data)
+		: data(std::move(data))
+	{}
+
+	EphemerisCache::~EphemerisCache() = default;
+
+	bool EphemerisCache::Contains(EPlanet planet) const
+	{
+		for (UInt32 i = 0; i < data->header->bodiesCount; ++i)
+		{
+			if (data->bodies[i].planet == Int32(planet))
+			{
+				return true;
+			}
+		}
+		return false;
+	}
+
+	auto EphemerisCache::GetBody(EPlanet planet) const -> const Body&
+	{
+		for (UInt32 i = 0; i < data->header->bodiesCount; ++i)
+		{
+			if (data->bodies[i].planet == Int32(planet))
+			{
+				return data->bodies[i];
+			}
+		}
+		throw std::out_of_range("the body isn't cached: " + std::to_string(Int32(planet)));
+	}
+
+	FReal EphemerisCache::GetGM(EPlanet planet) const
+	{
+		return GetBody(planet).GM;
+	}
+
+	auto EphemerisCache::GetRange(EPlanet planet) const -> std::tuple<FReal, FReal>
+	{
+		auto& body = GetBody(planet);
+		return { body.firstBlock * body.stepSize, (body.firstBlock + Int64(body.count)) * body.stepSize };
+	}
+
+	auto EphemerisCache::MakeScript(EPlanet planet, const std::string& J2000Time) const -> PlanetScript::ptr
+	{
+		if (J2000Time != data->header->startDate)
+		{
+			throw std::runtime_error("the cache was built for another start date: '" + std::string(data->header->startDate) + "'");
+		}
+
+		auto& body   = GetBody(planet);
+		auto  script = std::make_shared<PlanetScript>(planet, body.t0, body.GM, body.T);
+		script->MakeDiscret(body.stepSize, body.chunkSize);
+
+		using Table = Ephemerides::EphemerisTable;
+		auto  begin = reinterpret_cast<const FReal*>(static_cast<const char*>(data->region.get_address()) + body.offset);
+		auto  columns = Table::Columns();
+		for (auto column = 0; column < Table::eColumnsCount; ++column)
+		{
+			columns[column] = begin + column * body.count;
+		}
+		script->AttachTable(std::make_unique<Table>(body.firstBlock, body.stepSize, size_t(body.count), columns, data));
+		return script;
+	}
+}
@@ -0,0 +1,82 @@
+#include "trajectory/ephemerisTable.hpp"
+
+
+
+namespace Pathfinder::Ephemerides
+{
+	EphemerisTable::EphemerisTable(Int64 firstBlock, FReal stepSize, size_t count)
+		: firstBlock(firstBlock)
+		, stepSize(stepSize)
+		, count(count)
+		, storage(count * eColumnsCount, 0)
+	{
+		if (!(stepSize > 0))
+		{
+			throw std::runtime_error("table step size must be positive");
+		}
+		for (auto i = 0; i < eColumnsCount; ++i)
+		{
+			columns[i] = storage.data() + i * count;
+		}
+	}
+
+	EphemerisTable::EphemerisTable(Int64 firstBlock, FReal stepSize, size_t count, const Columns& columns, Owner owner)
+		: firstBlock(firstBlock)
+		, stepSize(stepSize)
+		, count(count)
+		, columns(columns)
+		, owner(std::move(owner))
+	{
+		if (!(stepSize > 0))
+		{
+			throw std::runtime_error("table step size must be positive");
+		}
+		for (auto column : columns)
+		{
+			if (!column && count)
+			{
+				throw std::runtime_error("table columns cannot be nulled");
+			}
+		}
+	}
+
+	void EphemerisTable::SetRow(size_t row, const FVector& R, const FVector& V)
+	{
+		if (storage.empty() || row >= count)
+		{
+			throw std::out_of_range("the row cannot be set: " + std::to_string(row));
+		}
+		storage[eRX * count + row] = R.x;
+		storage[eRY * count + row] = R.y;
+		storage[eRZ * count + row] = R.z;
+		storage[eVX * count + row] = V.x;
+		storage[eVY * count + row] = V.y;
+		storage[eVZ * count + row] = V.z;
+	}
+
+	FReal EphemerisTable::GetSampleTime(size_t row) const
+	{
+		// \note: the middle of the block is used to be far from rounding on the block's bounds
+		return (firstBlock + Int64(row) + FReal(0.5)) * stepSize;
+	}
+
+	Int64 EphemerisTable::GetFirstBlock() const
+	{
+		return firstBlock;
+	}
+
+	FReal EphemerisTable::GetStepSize() const
+	{
+		return stepSize;
+	}
+
+	size_t EphemerisTable::GetCount() const
+	{
+		return count;
+	}
+
+	const FReal* EphemerisTable::GetColumn(EColumn column) const
+	{
+		return columns[column];
+	}
+}
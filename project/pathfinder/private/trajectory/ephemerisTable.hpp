@@ -0,0 +1,75 @@
+#ifndef PATHFINDER__EPHEMERISTABLE_HPP
+#define PATHFINDER__EPHEMERISTABLE_HPP
+
+#include <boost/noncopyable.hpp>
+#include "interfaces/ephemerides.hpp"
+#include <array>
+
+
+
+namespace Pathfinder::Ephemerides
+{
+	// EphemerisTable is a flat structure-of-arrays table of body states sampled with a constant step
+	// \note: a row i answers all the times of the block (firstBlock + i), i.e. floor(t / stepSize) == firstBlock + i
+	// \note: the table either owns its columns or views columns kept alive by an owner (e.g. a mapped file)
+	class EphemerisTable final : boost::noncopyable
+	{
+	public:
+		enum EColumn
+		{
+			  eRX, eRY, eRZ
+			, eVX, eVY, eVZ
+			, eColumnsCount
+		};
+
+		using Columns = std::array<const FReal*, eColumnsCount>;
+		using Owner   = std::shared_ptr<const void>;
+
+	public:
+		// creates a table with own zeroed columns
+		EphemerisTable(Int64 firstBlock, FReal stepSize, size_t count);
+
+		// creates a view over the columns
+		EphemerisTable(Int64 firstBlock, FReal stepSize, size_t count, const Columns& columns, Owner owner);
+
+		// returns a row containing the time or -1 if the time is out of the table
+		Int64 GetRow(FReal time) const
+		{
+			auto row = Int64(std::floor(time / stepSize)) - firstBlock;
+			return row >= 0 && row < Int64(count) ? row : -1;
+		}
+
+		FVector GetLocation(size_t row) const
+		{
+			return { columns[eRX][row], columns[eRY][row], columns[eRZ][row] };
+		}
+
+		FVector GetVelocity(size_t row) const
+		{
+			return { columns[eVX][row], columns[eVY][row], columns[eVZ][row] };
+		}
+
+		// sets a row of an owning table
+		void SetRow(size_t row, const FVector& R, const FVector& V);
+
+		// returns a time the row's state must be sampled at
+		FReal GetSampleTime(size_t row) const;
+
+		Int64  GetFirstBlock() const;
+		FReal  GetStepSize() const;
+		size_t GetCount() const;
+		const FReal* GetColumn(EColumn column) const;
+
+	private:
+		Int64  firstBlock = 0;
+		FReal  stepSize = 0;
+		size_t count = 0;
+
+		Columns columns;
+		std::vector<FReal> storage;
+		Owner owner;
+	};
+}
+
+
+#endif //!PATHFINDER__EPHEMERISTABLE_HPP
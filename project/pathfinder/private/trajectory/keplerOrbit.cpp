@@ -159,6 +159,119 @@ namespace Pathfinder::Kepler::Elliptic
 		auto pi2 = 2 * Math::Pi;
 		return f - pi2 * std::floor(f / pi2);
 	}
+
+
+	void Batch::Resize(size_t count)
+	{
+		for (auto column : { &f0, &e, &p, &w, &q0, &q1, &a, &E0, &E1, &M0, &M1, &dt })
+		{
+			column->resize(count);
+		}
+		bf.resize(count);
+		valid.resize(count);
+	}
+
+	size_t Batch::GetCount() const
+	{
+		return f0.size();
+	}
+
+	namespace
+	{
+		// mirrors of the scalar functions with selections instead of branches
+		inline auto QQ(FReal Q0, FReal Q1, FReal w)->std::tuple<FReal, FReal>
+		{
+			auto q0 = NZ(Q0 + w);
+			auto q1 = NZ(Q1 + w);
+			return { q0, q1 > q0 ? q1 : q1 + 2*Math::Pi };
+		}
+
+		inline auto EP(FReal r0, FReal r1, FReal q0, FReal q1, bool bCircular)->std::tuple<FReal, FReal>
+		{
+			auto C0 = Math::Cos(q0);
+			auto C1 = Math::Cos(q1);
+			auto den = r0 * C0 - r1 * C1;
+			return {
+				bCircular ? FReal(0.f) : (r1 - r0) / den,
+				bCircular ? r0         : (C0 - C1) / den * r0 * r1
+			};
+		}
+
+		inline FReal EA(FReal qi, FReal e)
+		{
+			using namespace Math;
+			auto Cq = Cos(qi);
+			auto AC = Acos((e + Cq) / (1 + e*Cq));
+			auto Ei = qi < 1*Pi ? +AC + 0*Pi
+				:	  qi < 2*Pi ? -AC + 2*Pi
+				:	  qi < 3*Pi ? +AC + 2*Pi
+				:				  -AC + 4*Pi
+				;
+			return Equal(e, 0, 10e-7) ? qi : Ei;
+		}
+	}
+
+	void Solve(Batch& batch, FReal r0, FReal r1, FReal Q0, FReal Q1, FReal GM)
+	{
+		using namespace Math;
+
+		const auto count = batch.GetCount();
+		const auto delta = r0/r1 - 1;
+		const auto bCircular = Equal(delta, 0, 10e-5);
+		const auto num = 1 - Cos(Q1 - Q0);
+		const auto sQ  = Sin(Q1 - Q0);
+		const auto wC  = Pi/2 * Sign(Q0 - Q1);
+
+		const auto f0 = batch.f0.data();
+		auto e  = batch.e .data(); auto p  = batch.p .data(); auto w  = batch.w .data();
+		auto q0 = batch.q0.data(); auto q1 = batch.q1.data(); auto a  = batch.a .data();
+		auto E0 = batch.E0.data(); auto E1 = batch.E1.data();
+		auto M0 = batch.M0.data(); auto M1 = batch.M1.data();
+		auto dt = batch.dt.data();
+		auto bf = batch.bf.data(); auto valid = batch.valid.data();
+
+		// orbit's orientation: both candidates of epwqq are solved, and the first suitable one is selected
+		for (size_t i = 0; i < count; ++i)
+		{
+			auto w0 = bCircular ? wC : Atan(num / (delta*Tan(Q0 - f0[i]) - sQ)) - Q0;
+			auto w1 = w0 + Pi;
+
+			auto [q00, q10] = QQ(Q0, Q1, w0);
+			auto [q01, q11] = QQ(Q0, Q1, w1);
+			auto [e0, p0] = EP(r0, r1, q00, q10, bCircular);
+			auto [e1, p1] = EP(r0, r1, q01, q11, bCircular);
+
+			auto bOK0 = 0 <= e0 && e0 < 0.99;
+			auto bOK1 = 0 <= e1 && e1 < 0.99;
+			auto bBreak0 = p0 <= 0 || Abs(e0) > 1;
+			auto bBreak1 = p1 <= 0 || Abs(e1) > 1;
+
+			e [i] = bOK0 ? e0  : e1;
+			p [i] = bOK0 ? p0  : p1;
+			w [i] = bOK0 ? w0  : w1;
+			q0[i] = bOK0 ? q00 : q01;
+			q1[i] = bOK0 ? q10 : q11;
+			valid[i] = !Equal(Q0, f0[i], 10e-5) && !bBreak0 && (bOK0 || (!bBreak1 && bOK1));
+			bf[i] = NZ(f0[i] - Q0) < Pi;
+		}
+
+		// flight times
+		for (size_t i = 0; i < count; ++i)
+		{
+			a [i] = p[i] / (1 - e[i]*e[i]);
+			E0[i] = EA(q0[i], e[i]);
+			E1[i] = EA(q1[i], e[i]);
+			M0[i] = E0[i] - e[i] * Sin(E0[i]);
+			M1[i] = E1[i] - e[i] * Sin(E1[i]);
+
+			auto c = Sqrt(a[i] / GM * a[i] * a[i]);
+			dt[i] = bf[i]
+				? c * (0*Pi + (M1[i] - M0[i]))
+				: c * (2*Pi - (M1[i] - M0[i]))
+				;
+			valid[i] = valid[i] && !isinf(dt[i]) && !isnan(dt[i]);
+		}
+	}
 }
 
 
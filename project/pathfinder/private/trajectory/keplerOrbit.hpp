@@ -2,6 +2,7 @@
 #define PATHFINDER__KEPLERORBIT_HPP
 
 #include <tuple>
+#include <vector>
 #include "math/math.hpp"
 
 
@@ -39,6 +40,24 @@ namespace Pathfinder::Kepler::Elliptic
 	FReal f (FReal Qi, FReal qi, FReal e, bool bf);
 
 	FReal NZ(FReal f);
+
+	// Batch is a structure of arrays of transfers between two fixed points for many toss angles
+	struct Batch
+	{
+		std::vector<FReal> f0; // [rad] - normalised toss angles (input)
+		std::vector<FReal> e, p, w, q0, q1, a, E0, E1, M0, M1, dt;
+		std::vector<UInt8> bf;
+		std::vector<UInt8> valid; // 1 - the transfer exists and its flight time is finite
+
+		void Resize(size_t count);
+		size_t GetCount() const;
+	};
+
+	// solves transfers for all the toss angles of the batch in one call
+	// \note: the lanes repeat epwqq, a, E, M and dt with selections instead of branches, and invalid lanes are masked out
+	// \note: the loops call scalar trigonometry, so they aren't vectorised and a lane costs as much as the scalar chain;
+	//        the batch only lets the callers share the work that doesn't depend on toss angles
+	void Solve(Batch& batch, FReal r0, FReal r1, FReal Q0, FReal Q1, FReal GM);
 }
 
 namespace Pathfinder::Kepler::Hiperbolic
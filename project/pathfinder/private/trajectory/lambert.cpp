@@ -0,0 +1,164 @@
+#include "trajectory/lambert.hpp"
+#include <cmath>
+
+
+
+namespace Pathfinder::Kepler::Lambert
+{
+	namespace
+	{
+		constexpr auto maxIters  = 35;
+		constexpr auto tolerance = 1e-11;
+
+		// Gauss' hypergeometric function 2F1(3, 1, 5/2, x)
+		FReal F(FReal x)
+		{
+			if (x >= 1)
+			{
+				return INFINITY;
+			}
+			auto res  = FReal(1);
+			auto term = FReal(1);
+			for (auto i = 0; i < 1000; ++i)
+			{
+				term *= (3 + i) * (1 + i) / (2.5 + i) * x / (i + 1);
+				auto prev = res;
+				res += term;
+				if (res == prev)
+				{
+					break;
+				}
+			}
+			return res;
+		}
+
+		FReal y(FReal x, FReal l)
+		{
+			return Math::Sqrt(1 - l*l * (1 - x*x));
+		}
+
+		FReal psi(FReal x, FReal y, FReal l)
+		{
+			if (-1 <= x && x < 1)
+			{
+				return Math::Acos(x*y + l * (1 - x*x));
+			}
+			if (x > 1)
+			{
+				return std::asinh((y - x*l) * Math::Sqrt(x*x - 1));
+			}
+			return 0;
+		}
+
+		// non dimensional time of flight of x
+		FReal T(FReal x, FReal y, FReal l)
+		{
+			using namespace Math;
+			if (Sqrt(0.6) < x && x < Sqrt(1.4))
+			{ // \note: near parabolic transfers the series is used (the closed form loses the precision)
+				auto eta = y - l*x;
+				auto S1  = (1 - l - x*eta) / 2;
+				auto Q   = 4. / 3 * F(S1);
+				return (eta*eta*eta * Q + 4 * l * eta) / 2;
+			}
+			return (psi(x, y, l) / Sqrt(Abs(1 - x*x)) - x + l*y) / (1 - x*x);
+		}
+
+		FReal x0(FReal T, FReal l)
+		{
+			using namespace Math;
+			auto T0 = Acos(l) + l * Sqrt(1 - l*l);
+			auto T1 = 2 * (1 - l*l*l) / 3;
+			if (T >= T0)
+			{
+				return std::pow(T0 / T, 2. / 3) - 1;
+			}
+			if (T < T1)
+			{
+				return 2.5 * T1 / T * (T1 - T) / (1 - std::pow(l, 5)) + 1;
+			}
+			return std::pow(T0 / T, std::log2(T1 / T0)) - 1;
+		}
+
+		// finds x of the time of flight T with Householder's iterations
+		auto x(FReal T0, FReal l)->std::tuple<FReal, bool>
+		{
+			using namespace Math;
+			auto xi = x0(T0, l);
+			for (auto i = 0; i < maxIters; ++i)
+			{
+				auto yi  = y(xi, l);
+				auto Ti  = T(xi, yi, l);
+				auto fi  = Ti - T0;
+				auto c   = 1 - xi*xi;
+				auto d1  = (3 * Ti * xi - 2 + 2 * l*l*l * xi / yi) / c;
+				auto d2  = (3 * Ti + 5 * xi * d1 + 2 * (1 - l*l) * l*l*l / (yi*yi*yi)) / c;
+				auto d3  = (7 * xi * d2 + 8 * d1 - 6 * (1 - l*l) * std::pow(l, 5) * xi / std::pow(yi, 5)) / c;
+				auto xn  = xi - fi * (d1*d1 - fi * d2 / 2) / (d1 * (d1*d1 - fi * d2) + d3 * fi*fi / 6);
+				if (isnan(xn))
+				{
+					break;
+				}
+				if (Abs(xn - xi) < tolerance)
+				{
+					return { xn, true };
+				}
+				xi = xn;
+			}
+			return { NAN, false };
+		}
+	}
+
+	auto VV(const FVector& R0, const FVector& R1, FReal tof, FReal GM, bool bPrograde) -> std::tuple<_VV, bool>
+	{
+		using namespace Math;
+		if (!(tof > 0))
+		{
+			return { _VV(), false };
+		}
+
+		auto r0 = R0.Size();
+		auto r1 = R1.Size();
+		auto c  = (R1 - R0).Size();
+		auto s  = (r0 + r1 + c) / 2;
+		auto H  = R0 ^ R1;
+		if (H.Size() <= Epsilon * r0 * r1)
+		{
+			return { _VV(), false };
+		}
+
+		auto i_r0 = R0 / r0;
+		auto i_r1 = R1 / r1;
+		auto i_h  = H.GetNormal();
+		auto l    = Sqrt(1 - Min(FReal(1), c / s));
+		if (i_h.z < 0)
+		{ // the transfer angle is greater then pi
+			l   = -l;
+			i_h = -i_h;
+		}
+		auto i_t0 = i_h ^ i_r0;
+		auto i_t1 = i_h ^ i_r1;
+		if (!bPrograde)
+		{
+			l    = -l;
+			i_t0 = -i_t0;
+			i_t1 = -i_t1;
+		}
+
+		auto [xs, bOK] = x(Sqrt(2 * GM / (s*s*s)) * tof, l);
+		if (!bOK)
+		{
+			return { _VV(), false };
+		}
+		auto ys    = y(xs, l);
+		auto gamma = Sqrt(GM * s / 2);
+		auto rho   = (r0 - r1) / c;
+		auto sigma = Sqrt(1 - rho*rho);
+
+		auto Vr0 = +gamma * ((l*ys - xs) - rho * (l*ys + xs)) / r0;
+		auto Vr1 = -gamma * ((l*ys - xs) + rho * (l*ys + xs)) / r1;
+		auto Vt0 =  gamma * sigma * (ys + l*xs) / r0;
+		auto Vt1 =  gamma * sigma * (ys + l*xs) / r1;
+		return { { i_r0 * Vr0 + i_t0 * Vt0, i_r1 * Vr1 + i_t1 * Vt1 }, true };
+	}
+}
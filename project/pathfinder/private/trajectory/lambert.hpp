@@ -0,0 +1,25 @@
+#ifndef PATHFINDER__LAMBERT_HPP
+#define PATHFINDER__LAMBERT_HPP
+
+#include <tuple>
+#include "math/math.hpp"
+
+
+
+namespace Pathfinder::Kepler::Lambert
+{
+	struct _VV
+	{
+		FVector V0; // [m/s] - departure velocity
+		FVector V1; // [m/s] - arrival velocity
+	};
+
+	// solves Lambert's problem: finds the transfer from R0 to R1 lasting tof (without full revolutions)
+	// \note:	Izzo's method (D. Izzo, "Revisiting Lambert's problem", 2015); bPrograde selects the 
+	//			transfer moving counterclockwise about the z axis, otherwise the clockwise one is taken
+	// \note:	fails for collinear R0 and R1 (the transfer plane is undefined) and if the iterations diverge
+	auto VV(const FVector& R0, const FVector& R1, FReal tof, FReal GM, bool bPrograde)->std::tuple<_VV, bool>;
+}
+
+
+#endif //!PATHFINDER__LAMBERT_HPP
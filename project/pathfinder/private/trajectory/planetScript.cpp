@@ -1,4 +1,6 @@
 #include "planetScript.hpp"
+#include "trajectory/chunkTable.hpp"
+#include "trajectory/ephemerisTable.hpp"
 #include <SpiceUsr.h>
 #include <array>
 
@@ -37,9 +39,11 @@ namespace Pathfinder::PlanetScript::utiles
 		}
 	}
 
+	// \note: CSPICE isn't thread safe, so all the calls are serialised
 	class SPICE final : boost::noncopyable
 	{
 		bool bInitialised = false;
+		std::mutex mutex;
 
 	public:
 		static SPICE& Get(bool bFromInitialiser = false)
@@ -103,6 +107,7 @@ namespace Pathfinder::PlanetScript::utiles
 
 		FReal GetAbsTime(const std::string& time)
 		{
+			auto lock = std::lock_guard(mutex);
 			SpiceDouble et = 0;
 			str2et_c(time.c_str(), &et);
 			assert(et);
@@ -114,6 +119,7 @@ namespace Pathfinder::PlanetScript::utiles
 			// \see: https://naif.jpl.nasa.gov/pub/naif/toolkit_docs/C/cspice/oscltx_c.html
 			auto state = GetRawMovement(body, time);
 			auto gm    = GetRawGM(primatyBody);
+			auto lock = std::lock_guard(mutex);
 			SpiceDouble params[20];
 			oscltx_c(&state.front(), time, gm, params);
 			return params[10];
@@ -124,6 +130,7 @@ namespace Pathfinder::PlanetScript::utiles
 		// position + velocity in km
 		std::array<SpiceDouble,6> GetRawMovement(const std::string& name, FReal time)
 		{
+			auto lock  = std::lock_guard(mutex);
 			auto state = std::array<SpiceDouble,6>();
 			SpiceDouble lightTime = 0;
 			spkezr_c(name.c_str(), time, "J2000", "NONE", "SSB", &state.front(), &lightTime);
@@ -132,6 +139,7 @@ namespace Pathfinder::PlanetScript::utiles
 
 		SpiceDouble GetRawGM(const std::string& name)
 		{
+			auto lock = std::lock_guard(mutex);
 			SpiceInt n = 0;
 			SpiceDouble gm = 0;
 			bodvrd_c(name.c_str(), "GM", 1, &n, &gm);
@@ -175,6 +183,16 @@ namespace Pathfinder::PlanetScript
 		}
 	}
 
+	PlanetScript::PlanetScript(EPlanet planet, FReal t0, FReal GM, FReal T)
+		: name  (utiles::GetSPICEName(planet))
+		, center(utiles::GetSPICEName(utiles::GetCenterBody(planet)))
+		, T (T )
+		, t0(t0)
+		, GM(GM)
+	{}
+
+	PlanetScript::~PlanetScript() = default;
+
 	FReal PlanetScript::GetT(FReal time) const
 	{
 		return T;
@@ -189,7 +207,7 @@ namespace Pathfinder::PlanetScript
 	{
 		if (IsDiscret())
 		{
-			auto& [r, v] = GetMovement_D(time);
+			auto [r, v] = GetMovement_D(time);
 			return r;
 		}
 		return GetLocation_C(time);
@@ -199,7 +217,7 @@ namespace Pathfinder::PlanetScript
 	{
 		if (IsDiscret())
 		{
-			auto& [r, v] = GetMovement_D(time);
+			auto [r, v] = GetMovement_D(time);
 			return v;
 		}
 		return GetVelocity_C(time);
@@ -225,6 +243,7 @@ namespace Pathfinder::PlanetScript
 		{
 			stepSize = stepSize_;
 			chunkSize = chunkSize_;
+			chunks = std::make_unique<Chunks>();
 		}
 		else
 		{
@@ -232,31 +251,99 @@ namespace Pathfinder::PlanetScript
 		}
 	}
 
+	const Ephemerides::EphemerisTable* PlanetScript::GetTable() const
+	{
+		return table.get();
+	}
+
+	FReal PlanetScript::GetStepSize() const
+	{
+		return stepSize;
+	}
+
+	void PlanetScript::Preload(FReal tBegin, FReal tEnd)
+	{
+		if (!IsDiscret())
+		{
+			throw std::runtime_error("only discret ephemerides can be preloaded");
+		}
+		if (!(tBegin <= tEnd))
+		{
+			throw std::runtime_error("preload range must not be empty");
+		}
+
+		auto firstBlock = Int64(std::floor(tBegin / stepSize));
+		auto lastBlock  = Int64(std::floor(tEnd   / stepSize));
+		auto newTable   = std::make_unique<Ephemerides::EphemerisTable>(firstBlock, stepSize, size_t(lastBlock - firstBlock + 1));
+		for (size_t row = 0; row < newTable->GetCount(); ++row)
+		{
+			// \note: the rows are copied from the chunks, so the table answers exactly as the chunks do
+			auto& [R, V] = GetMovement_D_Chunks(newTable->GetSampleTime(row));
+			newTable->SetRow(row, R, V);
+		}
+		table = std::move(newTable);
+	}
+
+	void PlanetScript::AttachTable(std::unique_ptr<Ephemerides::EphemerisTable> newTable)
+	{
+		if (!IsDiscret())
+		{
+			throw std::runtime_error("a table can be attached only to discret ephemerides");
+		}
+		if (newTable && newTable->GetStepSize() != stepSize)
+		{
+			throw std::runtime_error("the table's step size must match the ephemerides' one");
+		}
+		table = std::move(newTable);
+		bTableOnly = bool(table);
+	}
+
 	bool PlanetScript::IsDiscret() const
 	{
 		return stepSize > 0;
 	}
 
-	const PlanetScript::MovState& PlanetScript::GetMovement_D(FReal time) const
+	FReal PlanetScript::GetStartTime() const
 	{
-		UInt64 chunkN = time / chunkSize;
-		UInt64 blockN = time / stepSize;
+		return t0;
+	}
 
-		auto pos = chunks.find(chunkN);
-		auto end = chunks.end();
-		if (pos != end)
+	auto PlanetScript::GetDiscretisation() const -> std::tuple<FReal, FReal>
+	{
+		return { stepSize, chunkSize };
+	}
+
+	auto PlanetScript::GetMovement_D(FReal time) const -> MovState
+	{
+		if (table)
 		{
-			return pos->second.at(blockN);
+			if (auto row = table->GetRow(time); row >= 0)
+			{
+				return { table->GetLocation(row), table->GetVelocity(row) };
+			}
 		}
-		
-		const_cast<PlanetScript*>(this)->AddChunk(chunkN);
+		if (bTableOnly)
+		{
+			throw std::runtime_error("t=" + std::to_string(time) + " s is outside the ephemerides cache of " + name);
+		}
+		return GetMovement_D_Chunks(time);
+	}
 
-		pos = chunks.find(chunkN);
-		end = chunks.end();
-		if (pos != end)
+	auto PlanetScript::GetMovement_D_Chunks(FReal time) const -> const MovState&
+	{
+		auto chunkN = Int64(std::floor(time / chunkSize));
+		auto blockN = Int64(std::floor(time / stepSize));
+
+		auto& chunk = chunks->GetOrFill(chunkN, [this](Int64 chunkN, Chunk& chunk)
 		{
-			return pos->second.at(blockN);
-		}		
+			FillChunk(chunkN, chunk);
+		});
+
+		auto index = blockN - chunk.firstBlock;
+		if (index >= 0 && index < Int64(chunk.states.size()))
+		{
+			return chunk.states[index];
+		}
 		throw std::runtime_error("cannot get discret value fot t=" + std::to_string(time) + " s");
 	}
 
@@ -275,15 +362,14 @@ namespace Pathfinder::PlanetScript
 		return utiles::SPICE::Get().GetMovement(name, t0 + time);
 	}
 
-	void PlanetScript::AddChunk(UInt64 chunkN)
+	void PlanetScript::FillChunk(Int64 chunkN, Chunk& chunk) const
 	{
-		auto& chunk = chunks[chunkN];
 		FReal ti = chunkSize * chunkN;
 		FReal t1 = chunkSize + ti + stepSize;
-		UInt64 N = ti / stepSize;
-		for (; ti < t1; ti += stepSize, ++N)
+		chunk.firstBlock = Int64(std::floor(ti / stepSize));
+		for (; ti < t1; ti += stepSize)
 		{
-			chunk[N] = GetMovement_C(ti);
+			chunk.states.push_back(GetMovement_C(ti));
 		}
 	}
 }
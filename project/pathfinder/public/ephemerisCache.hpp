@@ -0,0 +1,62 @@
+#ifndef PATHFINDER__EPHEMERISCACHE_HPP
+#define PATHFINDER__EPHEMERISCACHE_HPP
+
+#include "planetScript.hpp"
+
+
+namespace Pathfinder::PlanetScript
+{
+	// EphemerisCache is a versioned binary file of discrete ephemerides of several bodies
+	// \note: the file is memory mapped and its columns are used as the scripts' tables as is,
+	//        so opening the cache costs no SPICE calls and no copies
+	// \note: the file is written in the machine's native byte order
+	class EphemerisCache final : boost::noncopyable
+	{
+	public:
+		using ptr = std::shared_ptr<const EphemerisCache>;
+
+		static constexpr UInt32 version = 1;
+
+	public:
+		// samples the bodies over [tBegin, tEnd] with SPICE and writes them to the file
+		static void Build(
+			  const std::string& path
+			, const std::string& J2000Time
+			, const std::vector<EPlanet>& planets
+			, FReal stepSize
+			, FReal chunkSize
+			, FReal tBegin
+			, FReal tEnd
+		);
+
+		// maps the file into memory
+		static ptr Open(const std::string& path);
+
+		~EphemerisCache();
+
+		bool Contains(EPlanet planet) const;
+
+		FReal GetGM(EPlanet planet) const;
+
+		// returns a time range [tBegin, tEnd) the body's states are cached for
+		auto GetRange(EPlanet planet) const->std::tuple<FReal, FReal>;
+
+		// creates a discret script answering the cached range from the file
+		// \note: times out of the range throw, the script never calls SPICE
+		auto MakeScript(EPlanet planet, const std::string& J2000Time) const->PlanetScript::ptr;
+
+	private:
+		struct Body;
+		struct Data;
+
+		EphemerisCache(std::shared_ptr<const Data> data);
+
+		auto GetBody(EPlanet planet) const->const Body&;
+
+	private:
+		std::shared_ptr<const Data> data;
+	};
+}
+
+
+#endif //!PATHFINDER__EPHEMERISCACHE_HPP
@@ -7,6 +7,8 @@
 
 namespace Pathfinder::Ephemerides
 {
+	class EphemerisTable;
+
 	// IEphemerides is a connaction to a planet ephemerides engine/database
 	struct IEphemerides
 	{
@@ -19,6 +21,13 @@ namespace Pathfinder::Ephemerides
 		virtual FVector GetLocation(FReal time) const = 0;
 		virtual FVector GetVelocity(FReal time) const = 0;
 		virtual auto GetMovement(FReal time)->std::tuple<FVector, FVector> const = 0;
+
+		// returns a flat table that answers the same as the getters inside its time range
+		// \note: clients read rows of the table directly to skip virtual calls and lookups
+		virtual const EphemerisTable* GetTable() const { return nullptr; }
+
+		// returns a step of discrete ephemerides: the states are the same inside of each block floor(time / step) (0 - continuous)
+		virtual FReal GetStepSize() const { return 0; }
 	};
 }
 
@@ -66,6 +66,21 @@ namespace Pathfinder::Nodes
 
 namespace Pathfinder
 {
+	// solvers of legs to scripted nodes
+	enum class ELinkSolver
+	{
+		  eScan    // scans arrival times for every toss angle and refines roots of the flight time mismatch
+		, eLambert // solves Lambert's problem for every arrival time of the scan grid (points_f0 is ignored)
+	};
+
+	// strategies polishing the roots of the flight time mismatch the scan has bracketed
+	enum class ERootPolisher
+	{
+		  eBisection // halves sign changes, GSL's simplex for extrema (reference)
+		, eIllinois  // Illinois false position for sign changes, Brent's minimisation for extrema
+		, eBrent     // Brent's method for sign changes, Brent's minimisation for extrema
+	};
+
 	struct MissionConfig
 	{
 		FReal normalFlyPeriodFactor = NAN;
@@ -73,6 +88,9 @@ namespace Pathfinder
 		FReal timeStep  = NAN;
 		FReal timeFrac  = NAN;
 		FReal timeTol   = NAN;
+		Int32 threads   = 1; // max count of workers a stage can use (0 - one per hardware thread)
+		ELinkSolver linkSolver = ELinkSolver::eScan; // \note: SAX optimises toss angles, so it supports eScan only
+		ERootPolisher rootPolisher = ERootPolisher::eBisection;
 
 		void CopyValus(const MissionConfig& rhs)
 		{
@@ -81,7 +99,26 @@ namespace Pathfinder
 	};
 
 	struct FAXConfig : public MissionConfig
-	{};
+	{
+		size_t legCacheLimit = 0; // [bytes] - memory cap of legs memoised across departure times (0 - no memoisation)
+		size_t pruneTopK = 0;     // count of the best flights branch and bound keeps (0 - all the flights are expanded)
+	};
+
+	// minimisers of SAX
+	enum class ESAXMinimiser
+	{
+		  eSimplex   // Nelder-Mead simplex (no gradients)
+		, eBFGS2     // BFGS with central difference gradients
+		, eConjugate // Polak-Ribiere conjugate gradients with central difference gradients
+	};
+
+	// global searches of SAX around FAX seeds
+	enum class ESAXGlobal
+	{
+		  eNone                  // one local minimisation from the seed
+		, eDifferentialEvolution // differential evolution (rand/1/bin) in a box around the seed
+		, eMultiStart            // local minimisations from the seed and from random points of the box
+	};
 
 	struct SAXConfig : public MissionConfig
 	{
@@ -95,6 +132,17 @@ namespace Pathfinder
 		FReal initialTossAngleStep = 0.001;
 		FReal initialBurnPointStep = 1.e+6;
 		FReal initialTimeStep = 3600. * 12;
+
+		ESAXMinimiser minimiser = ESAXMinimiser::eSimplex;
+		FReal gradientStep = 0.01; // [-] - central difference steps as fractions of the initial steps
+
+		ESAXGlobal global = ESAXGlobal::eNone;
+		UInt64 evaluationBudget = 2000; // evaluations of the functionality a flight's global search can use
+		Int32  globalPopulation = 20;   // population of the evolution / count of the restarts
+		FReal  globalSpread = 10;       // [-] - half width of the box around the seed in initial steps
+		FReal  deWeight = 0.7;          // [-] - differential weight of the evolution
+		FReal  deCrossover = 0.9;       // [-] - crossover probability of the evolution
+		UInt64 randomSeed = 0;          // seed of the random points (the search is reproducible)
 	};
 
 	struct Mission
@@ -3,6 +3,16 @@
 
 #include "mission.hpp"
 #include "links.hpp"
+#include <optional>
+
+
+namespace Pathfinder::Solvers
+{
+	class LegCache;
+	class Incumbent;
+	class ResultsFilter;
+	class LinkPool;
+}
 
 
 namespace Pathfinder
@@ -10,6 +20,7 @@ namespace Pathfinder
 	class PathFinder
 	{
 	public:
+		// FlightInfo is a leg of a flight record with a copy of its link
 		struct FlightInfo : public reflect::FArchived
 		{
 			ARCH_BEGIN(reflect::FArchived)
@@ -29,7 +40,40 @@ namespace Pathfinder
 			Link::Link link;
 		};
 
-		struct FlightChain : public reflect::FArchived
+		// FlightLeg is a leg of a flight chain
+		struct FlightLeg
+		{
+			FReal totalCorrection = 0;
+			FReal totalMismatch = 0;
+			FReal totalImpulse = 0;
+			FReal totalTime = 0;
+			FReal absTime = 0;
+			UInt32 link = 0; // index of the leg's link in the chain's pool
+		};
+
+		// FlightChain is a flight whose legs refer to links of a shared pool
+		// \note: the chains of the DBs share the finder's pool, so a link found once is kept once
+		// \note: a chain keeps its pool alive, so it can be resolved after the finder compacts or drops the pool
+		struct FlightChain
+		{
+			std::vector<FlightLeg> chain;
+			FReal Correction = 0;
+			FReal Mismatch = 0;
+			FReal Impulse = 0;
+			FReal totalTime = 0;
+			FReal startTime = 0;
+			Int32 clusterSize = 1; // count of the FAX flights the flight stands for (see ClusterResults)
+			std::shared_ptr<const Solvers::LinkPool> links; // pool of the legs' links
+
+			FlightChain() = default;
+			FlightChain(std::vector<FlightLeg>&& chain, std::shared_ptr<const Solvers::LinkPool> links);
+
+			// returns the link of the leg
+			const Link::Link& GetLink(size_t leg) const;
+		};
+
+		// FlightRecord is a flight chain with copies of its links, the form flights are serialised and traced in
+		struct FlightRecord : public reflect::FArchived
 		{
 			ARCH_BEGIN(reflect::FArchived)
 				ARCH_FIELD(, , chain)
@@ -38,6 +82,7 @@ namespace Pathfinder
 				ARCH_FIELD(, , Impulse)
 				ARCH_FIELD(, , totalTime)
 				ARCH_FIELD(, , startTime)
+				ARCH_FIELD(, , clusterSize)
 				ARCH_END()
 		public:
 			std::vector<FlightInfo> chain;
@@ -46,20 +91,50 @@ namespace Pathfinder
 			FReal Impulse = 0;
 			FReal totalTime = 0;
 			FReal startTime = 0;
+			Int32 clusterSize = 1;
 
-			FlightChain() = default;
-			FlightChain(std::vector<FlightInfo>&& chain);
+			FlightRecord() = default;
+			FlightRecord(const FlightChain& flight);
+
+			// returns a chain with a pool of its own links
+			auto ToChain() const->FlightChain;
 		};
 		
 		struct SecondApproxData
 		{
 			FlightChain chain;
 			FReal functionality = 0;
+			UInt64 evaluations = 0; // functionality's evaluations the minimiser used
+		};
+
+		struct LegCacheStats
+		{
+			UInt64 hits    = 0;
+			UInt64 misses  = 0;
+			UInt64 entries = 0;
+			UInt64 refused = 0; // legs which weren't kept due to the memory cap
+			size_t bytes   = 0;
 		};
 
 		using FirstApproxDB  = std::map<Int64, std::vector<FlightChain>>;
 		using SecondApproxDB = std::multimap<Int64, SecondApproxData>;
-		using Functionality  = std::function<FReal(const FlightChain&)>;
+		using Functionality  = std::function<FReal(const FlightChain&)>; // maps a flight's totals (see SetFunctionality)
+		using OnFirstApprox  = std::function<void(FReal timeOffset, const std::vector<FlightChain>& flights)>;
+		using OnSecondApprox = std::function<void(const FlightChain& seed, const std::optional<SecondApproxData>& result)>;
+
+		// SeedClustering merges near-identical FAX flights before SAX (see ClusterResults)
+		struct SeedClustering
+		{
+			FReal timeRadius = 0;  // [s]   - of start times and legs' flight times
+			FReal angleRadius = 0; // [rad] - of legs' toss angles
+		};
+
+		// OnlineFilter drops FAX flights while they are computed, so the DB stays bounded on long sweeps
+		struct OnlineFilter
+		{
+			size_t topK = 0;        // keeps the K best flights of all the launch dates (0 - no limit)
+			FReal keepFactor = NAN; // keeps flights with functionality <= min + (max - min) * keepFactor (NAN - no limit)
+		};
 
 	public:
 		PathFinder(Mission&& mission);
@@ -67,9 +142,41 @@ namespace Pathfinder
 		// creates a first approximation of flight trajectory
 		auto FirstApprox(FReal timeOffset = 0)->const std::vector<FlightChain>&;
 
+		// creates first approximations for all the time offsets using up to 'threads' workers
+		// \note: results are merged in the order of the offsets, so the DB doesn't depend on the count of workers
+		// \note: onDone is called in the merge order right after the offset's results are merged
+		void FirstApprox(const std::vector<FReal>& timeOffsets, size_t threads, OnFirstApprox onDone = nullptr);
+
+		// merges flights of the time offset computed earlier (e.g. read from a checkpoint) as FirstApprox would do
+		// \note: the flights pass the online filter as computed ones, so restored dates must be merged in their order
+		void RestoreFirstApprox(FReal timeOffset, std::vector<FlightChain>&& flights);
+
+		// sets a max count of workers used by computation stages (0 - one per hardware thread)
+		void SetThreads(size_t threads);
+
 		// sets a functionality to map flight to one real value
+		// \note: the functionality may read the totals only (Correction, Mismatch, Impulse, totalTime and startTime):
+		//        while SAX minimises, it's called with flights that have no legs and no links
 		void SetFunctionality(Functionality functionality);
 
+		// sets a lower bound of the functionality for partial flights
+		// \note: the bound gets a flight with no links, accumulated mismatch, impulse and time, and zero correction;
+		//        it must not exceed the functionality of any complete flight starting with the partial one
+		// \note: with faxConfig.pruneTopK > 0, partial flights whose bound exceeds the K-th best complete flight
+		//        found so far aren't expanded, and complete flights worse than it aren't kept;
+		//        the K best flights are always kept, but a count of the other ones depends on the order of computations
+		void SetPartialBound(Functionality bound);
+
+		// sets a filter applied to FAX flights as they are merged to the DB
+		// \note: min and max of the keep factor are taken over all the flights computed so far; so the left flights are
+		//        the ones FilterResults(min + (max - min) * keepFactor) would leave, except those that exceeded
+		//        a threshold of an earlier merge (the threshold moves when a later date widens [min, max])
+		// \note: the K best flights are never dropped; flights tied with the K-th one are kept till the full compaction
+		// \note: the DB is compacted each time it doubles; FirstApprox(timeOffsets, ...) ends with a full compaction
+		//        which leaves exactly K flights as KeepBestResults(K) does
+		// \note: GetFunctionalityBounds returns bounds of all the computed flights including the dropped ones
+		void SetOnlineFilter(const OnlineFilter& filter);
+
 		// returns lower and upped bounds of functionality spectrum of all computed path
 		auto GetFunctionalityBounds() const->std::tuple<FReal, FReal>;
 
@@ -77,9 +184,32 @@ namespace Pathfinder
 		void FilterResults(std::function<void(const FirstApproxDB& db)> visiter);
 		void FilterResults(FReal minFunctionalityToLeft);
 
+		// leaves the 'count' best flights of all the dates; returns a count of the left flights
+		// \note: flights of equal values are taken in the DB's order, and flights mapped to NaN are dropped
+		size_t KeepBestResults(size_t count);
+
+		// leaves the best flight of each cluster of near flights of all the dates; returns a count of the left flights
+		// \note: a left flight's clusterSize sums clusterSizes of its cluster, and SAX flights inherit it
+		// \note: see Solvers::ClusterFlights for the clusters
+		size_t ClusterResults(const SeedClustering& settings);
+
 		// splits left first approx flights on two passive parts with a point with velocity impulce.
 		// \note: count of links in SAX flight chain will be twice to the FAX's one
-		const SecondApproxDB& SecondApprox();
+		// \note: flights are optimised by up to saxConfig.threads workers; the DB doesn't depend on the count
+		// \note: onDone is called (one call at a time) for each optimised flight with its FAX seed
+		const SecondApproxDB& SecondApprox(OnSecondApprox onDone = nullptr);
+
+		// sets a result of a seed optimised earlier, so SecondApprox takes it instead of optimising an equal seed
+		// \note: seeds are equal if their start times and legs' toss angles, start times and flight times are;
+		//        seeds with no restored result are optimised whatever the DB was filtered by
+		// \note: a failed optimisation is restored as nullopt; a restored flight takes clusterSize of the seed
+		void RestoreSecondApprox(const FlightChain& seed, std::optional<SecondApproxData>&& result);
+
+		// returns counters of FAX leg memoisation (zeroes if it's disabled)
+		auto GetLegCacheStats() const->LegCacheStats;
+
+		// returns a count of flights cut by branch and bound (zero if it's disabled)
+		UInt64 GetPrunedCount() const;
 
 		size_t FAXDBSize() const;
 		size_t SAXDBSize() const;
@@ -88,14 +218,30 @@ namespace Pathfinder
 		const SecondApproxDB& GetSecondApproxDB() const;
 
 	protected:
-		void SecondApprox(const FlightChain& flight, Int64 t0);
+		auto SecondApprox(const FlightChain& flight) const->std::optional<SecondApproxData>;
+		auto FirstApproxAt(FReal t0)->std::vector<FlightChain>;
+		auto MergeFirstApprox(FReal t0, std::vector<FlightChain>&& flights)->const std::vector<FlightChain>&;
+		
+		// drops flights with functionality over the threshold; returns a count of the left ones
+		size_t FilterFirstApproxDB(FReal threshold, bool bEraseEmpty);
+
+		// moves the links of the DBs' flights to a new pool, so the links of the dropped flights are freed
+		void CompactLinks();
 
 	protected:
 		Mission mission;
+		std::shared_ptr<Solvers::LegCache> legCache;
+		std::shared_ptr<Solvers::Incumbent> incumbent;
+		std::shared_ptr<Solvers::ResultsFilter> resultsFilter;
+		std::shared_ptr<Solvers::LinkPool> links; // links of the DBs' flights
+		size_t compactedSize = 0;
+		size_t mergedSize = 0;
 		
 		Functionality functionality;
+		Functionality partialBound;
 		FirstApproxDB firstApproxDB;
 		SecondApproxDB secondApproxDB;
+		std::map<std::vector<FReal>, std::optional<SecondApproxData>> restoredSAX; // by seeds' keys
 	};
 }
 
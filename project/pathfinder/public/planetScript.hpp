@@ -19,13 +19,21 @@ namespace Pathfinder::PlanetScript
 
 	bool InitDatabases(const std::string& pathToKernels);
 
+	template<typename Chunk>
+	class ChunkTable;
+
 
 	class PlanetScript : public Ephemerides::IEphemerides
 	{
 	protected:
 		using MovState = std::tuple<FVector, FVector>;
-		using Chunk  = std::unordered_map<UInt64, MovState>;
-		using Chunks = std::unordered_map<UInt64, Chunk>;
+
+		struct Chunk
+		{
+			Int64 firstBlock = 0;
+			std::vector<MovState> states;
+		};
+		using Chunks = ChunkTable<Chunk>;
 
 	public:
 		using ptr = std::shared_ptr<PlanetScript>;
@@ -33,25 +41,51 @@ namespace Pathfinder::PlanetScript
 	public:
 		PlanetScript(EPlanet planet, const std::string& J2000Time);
 
+		// creates a script with known parameters without SPICE calls
+		// \note: the script must be made discret and get a table to answer without SPICE
+		PlanetScript(EPlanet planet, FReal t0, FReal GM, FReal T);
+
+		~PlanetScript() override;
+
 		FReal GetT (FReal time) const override;
 		FReal GetGM(FReal time) const override;
 		FVector GetLocation(FReal time) const override;
 		FVector GetVelocity(FReal time) const override;
 		auto GetMovement(FReal time)->std::tuple<FVector, FVector> const override;
 
+		const Ephemerides::EphemerisTable* GetTable() const override;
+		FReal GetStepSize() const override;
+
 		void MakeDiscret(FReal stepSize, FReal chunkSize);
 
+		// fills a flat table of discrete states for the time range
+		// \note: the table answers the times of the range without chunk lookups
+		// \note: must be called before the script is shared between threads
+		void Preload(FReal tBegin, FReal tEnd);
+
+		// sets a prepared table instead of the preloaded one
+		// \note: the attached table is the only source of the states, so times out of it throw instead of calling SPICE
+		// \note: must be called before the script is shared between threads
+		void AttachTable(std::unique_ptr<Ephemerides::EphemerisTable> newTable);
+
 		bool IsDiscret() const;
 
+		// returns an absolute time of the script's zero time
+		FReal GetStartTime() const;
+
+		// returns step and chunk sizes of the discret mode
+		auto GetDiscretisation() const->std::tuple<FReal, FReal>;
+
 	protected:
 
-		const MovState& GetMovement_D(FReal time) const;
+		auto GetMovement_D(FReal time) const->MovState;
+		auto GetMovement_D_Chunks(FReal time) const->const MovState&;
 
 		FVector GetLocation_C(FReal time) const;
 		FVector GetVelocity_C(FReal time) const;
 		auto GetMovement_C(FReal time)->std::tuple<FVector, FVector> const;
 
-		void AddChunk(UInt64 chunkN);
+		void FillChunk(Int64 chunkN, Chunk& chunk) const;
 
 	protected:
 		std::string name;
@@ -62,7 +96,9 @@ namespace Pathfinder::PlanetScript
 
 		FReal stepSize = 0;
 		FReal chunkSize = 0;
-		Chunks chunks;
+		std::unique_ptr<Chunks> chunks;
+		std::unique_ptr<Ephemerides::EphemerisTable> table;
+		bool bTableOnly = false;
 	};
 }
 
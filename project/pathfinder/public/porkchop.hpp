@@ -0,0 +1,64 @@
+#ifndef PATHFINDER__PORKCHOP_HPP
+#define PATHFINDER__PORKCHOP_HPP
+
+#include "interfaces/ephemerides.hpp"
+
+
+namespace Pathfinder::Porkchop
+{
+	struct PorkchopConfig
+	{
+		Ephemerides::IEphemerides::ptr A; // departure body
+		Ephemerides::IEphemerides::ptr B; // arrival body
+		FReal GM = NAN; // [m3/s2]
+
+		FReal t0 = NAN; // [s] - departure range begin
+		FReal t1 = NAN; // [s] - departure range end
+		FReal dt = NAN; // [s] - departure step
+
+		FReal tof0 = NAN; // [s] - flight time range begin
+		FReal tof1 = NAN; // [s] - flight time range end
+		FReal dtof = NAN; // [s] - flight time step
+
+		FReal points_f0 = 360; // count of toss angles scanned for each cell
+		FReal timeTol = 60; // [s] - flight time tolerance
+		Int32 threads = 1;  // max count of workers (0 - one per hardware thread)
+	};
+
+	struct Cell
+	{
+		FReal w0 = NAN; // [m/s] - departure excess velocity (NAN - no transfer was found)
+		FReal w1 = NAN; // [m/s] - arrival excess velocity
+		FReal f0 = NAN; // [rad] - toss angle of the transfer
+	};
+
+	// Porkchop evaluates a departure date x flight time grid of single-leg transfers
+	// \note: a cell keeps the transfer with the least total excess velocity (w0 + w1)
+	class Porkchop
+	{
+	public:
+		// called once per departure date in the dates' order
+		using OnRow = std::function<void(size_t row, const std::vector<Cell>& cells)>;
+
+	public:
+		Porkchop(const PorkchopConfig& config);
+
+		const std::vector<FReal>& GetDepartures() const;
+		const std::vector<FReal>& GetFlightTimes() const;
+
+		// evaluates the grid by blocks of rows in parallel and streams the rows
+		void Compute(const OnRow& onRow) const;
+
+		// evaluates a single row
+		void ComputeRow(size_t row, std::vector<Cell>& cells) const;
+
+	private:
+		PorkchopConfig conf;
+		std::vector<FReal> departures;
+		std::vector<FReal> flightTimes;
+		std::vector<FReal> f0s;
+	};
+}
+
+
+#endif //!PATHFINDER__PORKCHOP_HPP
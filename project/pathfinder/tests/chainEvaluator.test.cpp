@@ -0,0 +1,87 @@
+#include "gtest/gtest.h"
+#include "solvers/chainEvaluator.hpp"
+#include "circularMission.hpp"
+
+
+struct chainEvaluator_tests : public testing::Test
+{
+	// Earth -> Venus -> Mars with circular orbits
+	Pathfinder::Mission mission;
+	std::vector<std::vector<FReal>> f0s;
+
+	void SetUp() override
+	{
+		mission = Pathfinder::Circular::MakeFlybyMission();
+		f0s.resize(mission.nodes.size());
+	}
+
+	auto MakeChain()->std::vector<Pathfinder::Solvers::Utiles::NodeA>
+	{
+		auto chain = std::vector<Pathfinder::Solvers::Utiles::NodeA>();
+		for (size_t i = 0; i < mission.nodes.size(); ++i)
+		{
+			chain.push_back({ mission.nodes[i], f0s[i] });
+		}
+		return chain;
+	}
+};
+
+
+TEST_F(chainEvaluator_tests, sameAsComputeFlight)
+{
+	using namespace Pathfinder;
+	auto functionality = PathFinder::Functionality([](const PathFinder::FlightChain& flight)
+	{
+		return flight.Impulse + flight.Mismatch + flight.Correction;
+	});
+
+	auto chain = MakeChain();
+	auto evaluator = Solvers::Utiles::ChainEvaluator(mission.saxConfig, chain, mission.GM, true);
+
+	// \note: the toss angles change between the calls as a minimiser changes them
+	auto found = 0;
+	for (auto t0 : { 0., 3600. * 24 * 40 })
+	{
+		for (auto step = 0; step < 4; ++step)
+		{
+			for (auto& angles : f0s)
+			{
+				angles.clear();
+				for (auto i = 0; i < 30; ++i)
+				{
+					angles.push_back(DEG2RAD(12 * i + 3 * step));
+				}
+			}
+
+			auto flights  = Solvers::Utiles::ComputeFlight(mission.saxConfig, chain, t0, mission.GM, true);
+			auto expected = FReal(NAN);
+			for (auto& flight : flights)
+			{
+				auto value = functionality(flight);
+				if (value < expected || isnan(expected))
+				{
+					expected = value;
+				}
+			}
+
+			auto value = evaluator.Evaluate(t0, functionality);
+			if (isnan(expected))
+			{
+				EXPECT_TRUE(isnan(value));
+				continue;
+			}
+			EXPECT_EQ(value, expected) << "t0=" << t0 << ", step=" << step;
+			++found;
+		}
+	}
+	EXPECT_GT(found, 0);
+}
+
+TEST_F(chainEvaluator_tests, noLegs)
+{
+	using namespace Pathfinder;
+	mission.nodes.resize(1);
+	auto chain = MakeChain();
+	auto evaluator = Solvers::Utiles::ChainEvaluator(mission.saxConfig, chain, mission.GM);
+	EXPECT_TRUE(isnan(evaluator.Evaluate(0, [](const PathFinder::FlightChain&) { return 0.; })));
+}
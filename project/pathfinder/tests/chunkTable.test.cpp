@@ -0,0 +1,63 @@
+#include "gtest/gtest.h"
+#include "trajectory/chunkTable.hpp"
+#include <thread>
+
+
+struct chunkTable_tests : public testing::Test
+{
+	struct Chunk
+	{
+		Int64 chunkN = 0;
+	};
+	using Table = Pathfinder::PlanetScript::ChunkTable<Chunk>;
+};
+
+
+TEST_F(chunkTable_tests, fillOnce)
+{
+	auto table = Table();
+	auto fills = std::atomic<int>(0);
+	auto fill  = [&fills](Int64 chunkN, Chunk& chunk)
+	{
+		++fills;
+		chunk.chunkN = chunkN;
+	};
+
+	auto threads = std::vector<std::thread>();
+	auto results = std::vector<const Chunk*>(8, nullptr);
+	for (size_t i = 0; i < results.size(); ++i)
+	{
+		threads.emplace_back([&, i]()
+		{
+			results[i] = &table.GetOrFill(42, fill);
+		});
+	}
+	for (auto& thread : threads)
+	{
+		thread.join();
+	}
+
+	ASSERT_EQ(fills, 1);
+	for (auto result : results)
+	{
+		ASSERT_EQ(result, results.front());
+		ASSERT_EQ(result->chunkN, 42);
+	}
+	ASSERT_EQ(table.Find(42), results.front());
+}
+
+TEST_F(chunkTable_tests, bounds)
+{
+	auto table = Table();
+	auto fill  = [](Int64 chunkN, Chunk& chunk)
+	{
+		chunk.chunkN = chunkN;
+	};
+
+	ASSERT_EQ(table.Find(-1), nullptr);
+	ASSERT_EQ(table.GetOrFill(-1, fill).chunkN, -1);
+	ASSERT_EQ(table.GetOrFill(+Table::maxChunkN, fill).chunkN, +Table::maxChunkN);
+	ASSERT_EQ(table.GetOrFill(-Table::maxChunkN, fill).chunkN, -Table::maxChunkN);
+	ASSERT_THROW(table.GetOrFill(Table::maxChunkN + 1, fill), std::out_of_range);
+	ASSERT_THROW(table.Find(-Table::maxChunkN - 1), std::out_of_range);
+}
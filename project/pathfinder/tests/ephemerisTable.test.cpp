@@ -0,0 +1,77 @@
+#include "gtest/gtest.h"
+#include "trajectory/ephemerisTable.hpp"
+#include "trajectory/ephemeridesClient.hpp"
+#include "planetScriptSimple.hpp"
+
+
+struct ephemerisTable_tests : public testing::Test
+{
+	using Table = Pathfinder::Ephemerides::EphemerisTable;
+
+	// simple planet answering with a flat table sampled from itself
+	struct TabledPlanet : public Pathfinder::PlanetScript::PlanetScriptSimple
+	{
+		Table table;
+
+		TabledPlanet(Int64 firstBlock, FReal stepSize, size_t count)
+			: PlanetScriptSimple(3.986E+14, 149.6E+9, 31.6E+6, 0)
+			, table(firstBlock, stepSize, count)
+		{
+			for (size_t row = 0; row < count; ++row)
+			{
+				auto [R, V] = GetMovement(table.GetSampleTime(row));
+				table.SetRow(row, R, V);
+			}
+		}
+
+		const Table* GetTable() const override
+		{
+			return &table;
+		}
+	};
+};
+
+
+TEST_F(ephemerisTable_tests, rows)
+{
+	auto table = Table(-2, 10, 5);
+	EXPECT_EQ(table.GetRow(-20.1), -1);
+	EXPECT_EQ(table.GetRow(-20.0),  0);
+	EXPECT_EQ(table.GetRow(- 0.1),  1);
+	EXPECT_EQ(table.GetRow(  0.0),  2);
+	EXPECT_EQ(table.GetRow( 29.9),  4);
+	EXPECT_EQ(table.GetRow( 30.0), -1);
+
+	table.SetRow(3, FVector(1, 2, 3), FVector(4, 5, 6));
+	EXPECT_EQ(table.GetLocation(3), FVector(1, 2, 3));
+	EXPECT_EQ(table.GetVelocity(3), FVector(4, 5, 6));
+	EXPECT_EQ(table.GetColumn(Table::eVY)[3], 5);
+	EXPECT_THROW(table.SetRow(5, FVector(), FVector()), std::out_of_range);
+}
+
+TEST_F(ephemerisTable_tests, view)
+{
+	auto data  = std::make_shared<std::vector<FReal>>(std::vector<FReal>{ 1, 2, 3, 4, 5, 6 });
+	auto ptr   = data->data();
+	auto table = Table(0, 1, 1, { ptr, ptr + 1, ptr + 2, ptr + 3, ptr + 4, ptr + 5 }, data);
+	EXPECT_EQ(table.GetLocation(0), FVector(1, 2, 3));
+	EXPECT_EQ(table.GetVelocity(0), FVector(4, 5, 6));
+}
+
+TEST_F(ephemerisTable_tests, clientCursor)
+{
+	constexpr auto step = 3600. * 24;
+	auto planet = TabledPlanet(10, step, 20);
+	auto client = Pathfinder::Ephemerides::EphemeridesClient(&planet);
+
+	// inside the table: the block's state
+	client.SetTime(step * 15.7);
+	auto [R, V] = planet.GetMovement(planet.table.GetSampleTime(5));
+	EXPECT_EQ(client.GetLocation(), R);
+	EXPECT_EQ(client.GetVelocity(), V);
+
+	// outside the table: the driver's state
+	client.SetTime(step * 35.7);
+	EXPECT_EQ(client.GetLocation(), planet.GetLocation(step * 35.7));
+	EXPECT_EQ(client.GetVelocity(), planet.GetVelocity(step * 35.7));
+}
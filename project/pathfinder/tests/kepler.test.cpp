@@ -1,5 +1,6 @@
 #include "gtest/gtest.h"
 #include "trajectory/keplerOrbit.hpp"
+#include "trajectory/lambert.hpp"
 #include "math/math.hpp"
 #include "boost/format.hpp"
 
@@ -131,3 +132,70 @@ TEST_F(Kepler_tests, find_pew_noSolution)
 	auto [res, bOK] = af::epwqq(r0, r1, Q0, Q1, Q0);
 	ASSERT_FALSE(bOK);
 }
+
+TEST_F(Kepler_tests, batch)
+{
+	// the batch kernel answers lane by lane as the scalar functions do
+	auto batch = af::Batch();
+	batch.Resize(720);
+	for (size_t i = 0; i < batch.GetCount(); ++i)
+	{
+		batch.f0[i] = af::NZ(DEG2RAD(0.5 * i));
+	}
+	batch.f0[1] = Q0; // no solution
+
+	for (auto R1 : { r1, r0 })
+	{
+		af::Solve(batch, r0, R1, Q0, Q1, GM);
+
+		auto count = 0;
+		for (size_t i = 0; i < batch.GetCount(); ++i)
+		{
+			auto f0 = batch.f0[i];
+			auto [res, bOK] = af::epwqq(r0, R1, Q0, Q1, f0);
+			auto dt = bOK 
+				? af::dt(af::M(af::E(res.q0, r0, res.e), res.e), af::M(af::E(res.q1, R1, res.e), res.e), af::a(res.e, res.p), GM, af::bf(Q0, f0)) 
+				: NAN;
+			bOK = bOK && !isnan(dt) && !isinf(dt);
+
+			ASSERT_EQ(bool(batch.valid[i]), bOK) << "f0=" << f0;
+			ASSERT_EQ(bool(batch.bf[i]), af::bf(Q0, f0));
+			if (bOK)
+			{
+				EXPECT_DOUBLE_EQ(batch.e [i], res.e );
+				EXPECT_DOUBLE_EQ(batch.p [i], res.p );
+				EXPECT_DOUBLE_EQ(batch.w [i], res.w );
+				EXPECT_DOUBLE_EQ(batch.q0[i], res.q0);
+				EXPECT_DOUBLE_EQ(batch.q1[i], res.q1);
+				EXPECT_DOUBLE_EQ(batch.dt[i], dt);
+				++count;
+			}
+		}
+		EXPECT_GT(count, 0);
+		EXPECT_FALSE(batch.valid[1]);
+	}
+}
+
+TEST_F(Kepler_tests, lambert)
+{
+	namespace lb = Pathfinder::Kepler::Lambert;
+	auto R0 = FVector(Math::Cos(Q0), Math::Sin(Q0), 0) * r0;
+	auto R1 = FVector(Math::Cos(Q1), Math::Sin(Q1), 0) * r1;
+
+	// the transfer of the fixture takes t
+	auto [res, bOK] = lb::VV(R0, R1, t, GM, true);
+	ASSERT_TRUE(bOK);
+	ASSERT_VALUES(res.V0.Size(), v0);
+	ASSERT_VALUES(res.V1.Size(), v1);
+	ASSERT_VALUES(af::NZ(Math::Atan2(res.V0.y, res.V0.x)), f0);
+	ASSERT_VALUES(af::NZ(Math::Atan2(res.V1.y, res.V1.x)), f1);
+
+	// the retrograde transfer moves clockwise
+	auto [ret, bRet] = lb::VV(R0, R1, t, GM, false);
+	ASSERT_TRUE(bRet);
+	EXPECT_LT((R0 ^ ret.V0).z, 0);
+
+	// no plane and no flight time
+	EXPECT_FALSE(std::get<1>(lb::VV(R0, R0 * 2, t, GM, true)));
+	EXPECT_FALSE(std::get<1>(lb::VV(R0, R1, 0, GM, true)));
+}
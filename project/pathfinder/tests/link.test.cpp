@@ -1,6 +1,7 @@
 #include "gtest/gtest.h"
 #include "interfaces/ephemerides.hpp"
 #include "planetScriptSimple.hpp"
+#include "circularMission.hpp"
 #include "blocks/link.hpp"
 
 
@@ -82,6 +83,189 @@ TEST_F(Link_tests, cocentricOrbits_tangency)
 	EXPECT_NEAR(links[4].v1, 21482, 1e+2);
 }
 
+TEST_F(Link_tests, parallelTossAngles)
+{
+	using namespace Pathfinder;
+	auto A = PlanetScript::PlanetScriptSimple(3.986E+14, 149.6E+9, 31.6E+6, .5 + 0.);
+	auto B = PlanetScript::PlanetScriptSimple(4.282E+13, 227.9E+9, 59.4E+6, .5 + 0.776);
+	auto conf = Circular::MakeScriptedConfig(A, B);
+
+	auto f0s = std::vector<FReal>();
+	for (auto i = 0; i < 90; ++i)
+	{
+		f0s.push_back(DEG2RAD(4 * i));
+	}
+
+	auto serial = std::vector<Link::Link>();
+	Link::FindLinks(serial, conf, f0s);
+
+	conf.threads = 4;
+	auto parallel = std::vector<Link::Link>();
+	Link::FindLinks(parallel, conf, f0s);
+
+	ASSERT_GE(serial.size(), 1);
+	ASSERT_EQ(serial.size(), parallel.size());
+	for (size_t i = 0; i < serial.size(); ++i)
+	{
+		EXPECT_EQ(serial[i].f0, parallel[i].f0);
+		EXPECT_EQ(serial[i].t1, parallel[i].t1);
+		EXPECT_EQ(serial[i].v0, parallel[i].v0);
+	}
+}
+
+TEST_F(Link_tests, batchKernel)
+{
+	using namespace Pathfinder;
+	auto A = PlanetScript::PlanetScriptSimple(3.986E+14, 149.6E+9, 31.6E+6, .5 + 0.);
+	auto B = PlanetScript::PlanetScriptSimple(4.282E+13, 227.9E+9, 59.4E+6, .5 + 0.776);
+	auto C = PlanetScript::PlanetScriptSimple(1.327E+20, 0, 0, 0);
+
+	auto f0s = std::vector<FReal>();
+	for (auto i = 0; i < 90; ++i)
+	{
+		f0s.push_back(DEG2RAD(4 * i));
+	}
+	auto expectEqual = [](const std::vector<Link::Link>& scalar, const std::vector<Link::Link>& batch)
+	{
+		ASSERT_GE(scalar.size(), 1);
+		ASSERT_EQ(scalar.size(), batch.size());
+		for (size_t i = 0; i < scalar.size(); ++i)
+		{
+			EXPECT_EQ(scalar[i].f0, batch[i].f0);
+			EXPECT_DOUBLE_EQ(scalar[i].t1, batch[i].t1);
+			EXPECT_DOUBLE_EQ(scalar[i].v0, batch[i].v0);
+			EXPECT_DOUBLE_EQ(scalar[i].W1.x, batch[i].W1.x);
+		}
+	};
+
+	{ // static links
+		auto conf = Link::StaticLinkConfig();
+		conf.t0 = 0;
+		conf.SetA(A);
+		conf.RB = B.GetLocation(0);
+		conf.GM = C.GetGM(0);
+
+		auto scalar = std::vector<Link::Link>();
+		auto batch  = std::vector<Link::Link>();
+		Link::FindLinks(scalar, conf, f0s, Link::EKernel::eScalar);
+		Link::FindLinks(batch , conf, f0s, Link::EKernel::eBatch );
+		expectEqual(scalar, batch);
+	}
+
+	for (auto threads : { 1, 4 })
+	{ // scripted links
+		auto conf = Circular::MakeScriptedConfig(A, B);
+		conf.threads = threads;
+
+		auto scalar = std::vector<Link::Link>();
+		auto batch  = std::vector<Link::Link>();
+		Link::FindLinks(scalar, conf, f0s, Link::EKernel::eScalar);
+		Link::FindLinks(batch , conf, f0s, Link::EKernel::eBatch );
+		expectEqual(scalar, batch);
+	}
+}
+
+TEST_F(Link_tests, lambertSolver)
+{
+	using namespace Pathfinder;
+	auto A = PlanetScript::PlanetScriptSimple(3.986E+14, 149.6E+9, 31.6E+6, .5 + 0.);
+	auto B = PlanetScript::PlanetScriptSimple(4.282E+13, 227.9E+9, 59.4E+6, .5 + 0.776);
+	auto conf = Circular::MakeScriptedConfig(A, B);
+
+	auto scanned = std::vector<Link::Link>();
+	Link::FindLinks(scanned, conf, { DEG2RAD(90) });
+	ASSERT_GE(scanned.size(), 1);
+
+	// arriving when the scanned links do, Lambert's links repeat them
+	auto t1s = std::vector<FReal>();
+	for (auto& link : scanned)
+	{
+		t1s.push_back(link.t1);
+	}
+	auto solved = std::vector<Link::Link>();
+	Link::FindLambertLinks(solved, conf, t1s);
+	for (auto& link : scanned)
+	{
+		auto same = std::find_if(solved.begin(), solved.end(), [&link](const Link::Link& l)
+		{
+			return Math::Abs(l.t1 - link.t1) < 3600 && l.bf == link.bf;
+		});
+		ASSERT_NE(same, solved.end()) << link.t1;
+		EXPECT_NEAR(same->f0, link.f0, DEG2RAD(0.5));
+		EXPECT_NEAR(same->v0, link.v0, 1e+2);
+		EXPECT_NEAR(same->v1, link.v1, 1e+2);
+	}
+
+	// the scan grid's arrival times give links of both directions of motion
+	auto grid = std::vector<Link::Link>();
+	Link::FindLambertLinks(grid, conf);
+	ASSERT_GE(grid.size(), 1);
+	for (auto& link : grid)
+	{
+		EXPECT_GT(link.t1, conf.t0);
+		EXPECT_LT(link.t1, conf.te);
+		EXPECT_FALSE(isnan(link.W0.Sum()) || isnan(link.W1.Sum()));
+	}
+	EXPECT_TRUE(std::any_of(grid.begin(), grid.end(), [](const Link::Link& l) { return  l.bf; }));
+	EXPECT_TRUE(std::any_of(grid.begin(), grid.end(), [](const Link::Link& l) { return !l.bf; }));
+
+	conf.threads = 4;
+	auto parallel = std::vector<Link::Link>();
+	Link::FindLambertLinks(parallel, conf);
+	ASSERT_EQ(grid.size(), parallel.size());
+	for (size_t i = 0; i < grid.size(); ++i)
+	{
+		EXPECT_EQ(grid[i].f0, parallel[i].f0);
+		EXPECT_EQ(grid[i].t1, parallel[i].t1);
+	}
+}
+
+TEST_F(Link_tests, rootPolishers)
+{
+	using namespace Pathfinder;
+	auto A = PlanetScript::PlanetScriptSimple(3.986E+14, 149.6E+9, 31.6E+6, .5 + 0.);
+	auto B = PlanetScript::PlanetScriptSimple(4.282E+13, 227.9E+9, 59.4E+6, .5 + 0.776);
+	auto conf = Circular::MakeScriptedConfig(A, B, 3600.);
+
+	auto f0s = std::vector<FReal>();
+	for (auto i = 0; i < 90; ++i)
+	{
+		f0s.push_back(DEG2RAD(4 * i));
+	}
+
+	// \note: link.polish_* benchmarks run the same scan
+	auto Polish = [&](ERootPolisher polisher)
+	{
+		auto counters = Link::PolishCounters();
+		auto links = std::vector<Link::Link>();
+		conf.polisher = polisher;
+		conf.counters = &counters;
+		Link::FindLinks(links, conf, f0s);
+		return std::make_tuple(links, UInt64(counters.evaluations), UInt64(counters.found));
+	};
+
+	auto [bisection, bisectionEvals, bisectionFound] = Polish(ERootPolisher::eBisection);
+	auto [illinois , illinoisEvals , illinoisFound ] = Polish(ERootPolisher::eIllinois );
+	auto [brent    , brentEvals    , brentFound    ] = Polish(ERootPolisher::eBrent    );
+
+	ASSERT_GE(bisection.size(), 1);
+	EXPECT_GE(illinoisFound, bisectionFound);
+	EXPECT_GE(brentFound, bisectionFound);
+	EXPECT_LT(illinoisEvals, bisectionEvals);
+	EXPECT_LT(brentEvals, bisectionEvals);
+
+	// the same roots are found up to the tolerance
+	for (auto& polished : { illinois, brent })
+	{
+		ASSERT_EQ(polished.size(), bisection.size());
+		for (size_t i = 0; i < bisection.size(); ++i)
+		{
+			EXPECT_EQ(polished[i].f0, bisection[i].f0);
+			EXPECT_NEAR(polished[i].t1, bisection[i].t1, 2 * conf.tt);
+		}
+	}
+}
+
 TEST_F(Link_tests, 3DVelocity)
 {
 	namespace l = Pathfinder::Link;
@@ -114,15 +298,7 @@ TEST_F(Link_tests, twoParts)
 
 	auto baseLink = Link::Link();
 	{
-		auto conf = Link::ScriptedLinkConfig();
-		conf.t0 = 0;
-		conf.SetA(A);
-		conf.SetB(B);
-		conf.te = B.GetT(0);
-		conf.ts = B.GetT(0) / 160;
-		conf.tt = 3600 * 24;
-		conf.td = 3600 * 24 / 100;
-		conf.GM = C.GetGM(0);
+		auto conf = Circular::MakeScriptedConfig(A, B);
 
 		auto links = std::vector<Link::Link>();
 		Link::FindLinks(links, conf, { DEG2RAD(90) });
@@ -0,0 +1,49 @@
+#include "gtest/gtest.h"
+#include "solvers/pathTree.hpp"
+
+
+struct pathTree_tests : public testing::Test
+{
+	using Tree = Pathfinder::PathTree<int>;
+};
+
+
+TEST_F(pathTree_tests, paths)
+{
+	auto tree = Tree();
+	tree.RegisterOnAdded([](int& parent, int& child)
+	{
+		child += parent;
+	});
+	auto a  = tree.AppendPath(1);
+	auto b  = tree.AppendPath(10, a);
+	auto c  = tree.AppendPath(100, a);
+	auto bd = tree.AppendPath(1000, b);
+	EXPECT_EQ(a, Tree::rootID + 1);
+	EXPECT_EQ(tree.GetSize(), 5);
+
+	EXPECT_EQ(tree.GetPathByIF(c), 101);
+	EXPECT_EQ(tree.GetFullPathByID(bd), std::vector<int>({ 1, 11, 1011 }));
+	EXPECT_EQ(tree.GetFullPathByID(bd, true), std::vector<int>({ 11, 1011 }));
+	EXPECT_EQ(tree.GetFullPathByID(std::vector<Tree::pathID>{ c, b }, true), 
+		std::vector<std::vector<int>>({ { 101 }, { 11 } }));
+	EXPECT_THROW(tree.GetPathByIF(bd + 1), std::runtime_error);
+	EXPECT_THROW(tree.GetPathByIF(0), std::runtime_error);
+}
+
+TEST_F(pathTree_tests, growth)
+{
+	// appends move the nodes, so the parents must be found by IDs
+	auto tree = Tree();
+	tree.RegisterOnAdded([](int& parent, int& child)
+	{
+		child += parent;
+	});
+	auto leaf = Tree::rootID;
+	for (auto i = 0; i < 1000; ++i)
+	{
+		leaf = tree.AppendPath(1, leaf);
+	}
+	EXPECT_EQ(std::as_const(tree).GetPathByIF(leaf), 1000);
+	EXPECT_EQ(tree.GetFullPathByID(leaf, true).size(), 999);
+}
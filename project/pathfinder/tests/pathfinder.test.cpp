@@ -3,11 +3,113 @@
 #include "planetScript.hpp"
 #include "planetScriptSimple.hpp"
 #include "nodes.hpp"
+#include "circularMission.hpp"
+#include "metrics.hpp"
+#include <algorithm>
 
 
 
 struct pathfinder_tests : public testing::Test
-{};
+{
+	// DiscreteScript answers a script's states at the middles of step blocks, as discrete planet scripts do
+	struct DiscreteScript : public Pathfinder::Ephemerides::IEphemerides
+	{
+		IEphemerides::ptr script;
+		FReal step = 0;
+
+		DiscreteScript(IEphemerides::ptr script, FReal step) : script(std::move(script)), step(step) {}
+
+		FReal Sample(FReal time) const { return (std::floor(time / step) + FReal(0.5)) * step; }
+
+		FReal GetT (FReal time) const override { return script->GetT (time); }
+		FReal GetGM(FReal time) const override { return script->GetGM(time); }
+		FVector GetLocation(FReal time) const override { return script->GetLocation(Sample(time)); }
+		FVector GetVelocity(FReal time) const override { return script->GetVelocity(Sample(time)); }
+		auto GetMovement(FReal time)->std::tuple<FVector, FVector> const override { return script->GetMovement(Sample(time)); }
+		FReal GetStepSize() const override { return step; }
+	};
+
+	// makes the scripts of the mission discrete with the step of the time fraction
+	static void MakeDiscrete(Pathfinder::Mission& mission)
+	{
+		for (auto& node : mission.nodes)
+		{
+			if (auto [asScript, asStatic] = Pathfinder::Nodes::CastNode(node); asScript)
+			{
+				asScript->Script = std::make_shared<DiscreteScript>(asScript->Script, mission.faxConfig.timeFrac);
+			}
+		}
+	}
+
+	// adjusts a mission before its finder is made
+	using Configure = std::function<void(Pathfinder::Mission&)>;
+
+	static FReal GetImpulse(const Pathfinder::PathFinder::FlightChain& flight)
+	{
+		return flight.Impulse;
+	}
+
+	// Earth -> Mars mission with circular orbits
+	static Pathfinder::PathFinder MakeCircularFinder(Configure configure = nullptr)
+	{
+		auto mission = Pathfinder::Circular::MakeMission();
+		if (configure)
+		{
+			configure(mission);
+		}
+		return Pathfinder::PathFinder(std::move(mission));
+	}
+
+	// Earth -> Mars finder with SAX seeds: FAX flights of the offsets within 5% of the spread of their total impulses
+	// \note: the offsets are computed in parallel, the result doesn't depend on it
+	static Pathfinder::PathFinder MakeSeededFinder(Configure configure = nullptr, const std::vector<FReal>& offsets = { 0. })
+	{
+		auto finder = MakeCircularFinder(configure);
+		finder.SetFunctionality(GetImpulse);
+		finder.FirstApprox(offsets, offsets.size());
+
+		auto [min, max] = finder.GetFunctionalityBounds();
+		finder.FilterResults(min + (max - min) * 0.05);
+		return finder;
+	}
+
+	// Earth -> Venus -> Mars mission with circular orbits
+	static Pathfinder::PathFinder MakeFlybyFinder(Configure configure = nullptr)
+	{
+		using namespace Pathfinder;
+
+		auto mission = Circular::MakeFlybyMission();
+		if (configure)
+		{
+			configure(mission);
+		}
+
+		auto finder = PathFinder(std::move(mission));
+		auto value  = [](const PathFinder::FlightChain& flight)
+		{
+			return flight.Impulse + flight.Mismatch;
+		};
+		finder.SetFunctionality(value);
+		finder.SetPartialBound(value);
+		return finder;
+	}
+
+	static void ExpectEqualDBs(const Pathfinder::PathFinder::FirstApproxDB& db1, const Pathfinder::PathFinder::FirstApproxDB& db2)
+	{
+		ASSERT_EQ(db1.size(), db2.size());
+		for (auto& [t0, flights] : db1)
+		{
+			auto& other = db2.at(t0);
+			ASSERT_EQ(flights.size(), other.size());
+			for (size_t i = 0; i < flights.size(); ++i)
+			{
+				EXPECT_EQ(flights[i].Impulse  , other[i].Impulse  );
+				EXPECT_EQ(flights[i].totalTime, other[i].totalTime);
+				EXPECT_EQ(flights[i].startTime, other[i].startTime);
+			}
+		}
+	}
+};
 
 
 TEST_F(pathfinder_tests, circularOrbits)
@@ -49,7 +151,7 @@ TEST_F(pathfinder_tests, circularOrbits)
 	for (auto& path : paths)
 	{
 		ASSERT_EQ(path.chain.size(), 1);
-		links[path.Impulse] = path.chain.rbegin()->link;
+		links[path.Impulse] = path.GetLink(path.chain.size() - 1);
 	}
 	ASSERT_GE(paths.size(), 1);
 
@@ -60,6 +162,547 @@ TEST_F(pathfinder_tests, circularOrbits)
 	EXPECT_NEAR(top.t1, 2.23e+7, 0.1e+7);
 }
 
+TEST_F(pathfinder_tests, flightLinks)
+{
+	using namespace Pathfinder;
+
+	auto finder = MakeCircularFinder();
+	finder.SetFunctionality(GetImpulse);
+	auto flights = finder.FirstApprox(); // copies share the finder's pool
+	ASSERT_GT(flights.size(), 1);
+
+	// dropping flights moves the left ones to a new pool, and the copies keep the old one
+	auto [min, max] = finder.GetFunctionalityBounds();
+	finder.FilterResults(min + (max - min) * 0.05);
+	auto& kept = finder.GetFirstApproxDB().begin()->second;
+	ASSERT_GE(kept.size(), 1);
+	ASSERT_LT(kept.size(), flights.size());
+	EXPECT_NE(kept.front().links, flights.front().links);
+	for (auto& flight : kept)
+	{
+		auto pos = std::find_if(flights.begin(), flights.end(), [&](auto& copy) { return copy.Impulse == flight.Impulse; });
+		ASSERT_NE(pos, flights.end());
+		EXPECT_EQ(flight.GetLink(0).f0, pos->GetLink(0).f0);
+		EXPECT_EQ(flight.GetLink(0).dt, pos->GetLink(0).dt);
+	}
+
+	// a record keeps copies of the links, and its chain has a pool of its own
+	auto record = PathFinder::FlightRecord(kept.front());
+	auto chain  = record.ToChain();
+	ASSERT_EQ(chain.chain.size(), kept.front().chain.size());
+	EXPECT_NE(chain.links, kept.front().links);
+	EXPECT_EQ(chain.Impulse, kept.front().Impulse);
+	EXPECT_EQ(chain.startTime, kept.front().startTime);
+	EXPECT_EQ(chain.GetLink(0).f0, kept.front().GetLink(0).f0);
+	EXPECT_EQ(chain.GetLink(0).t0, kept.front().GetLink(0).t0);
+	EXPECT_THROW(PathFinder::FlightChain().GetLink(0), std::exception);
+}
+
+TEST_F(pathfinder_tests, parallelSweep)
+{
+	using namespace Pathfinder;
+
+	auto offsets = std::vector<FReal>();
+	for (auto i = 0; i < 8; ++i)
+	{
+		offsets.push_back(3600. * 24 * 10 * i);
+	}
+
+	auto serial = MakeCircularFinder();
+	for (auto t : offsets)
+	{
+		serial.FirstApprox(t);
+	}
+
+	auto merged = std::vector<FReal>();
+	auto parallel = MakeCircularFinder();
+	parallel.FirstApprox(offsets, 4, [&merged](FReal t, const auto&)
+	{
+		merged.push_back(t);
+	});
+	ASSERT_EQ(merged, offsets);
+
+	ExpectEqualDBs(serial.GetFirstApproxDB(), parallel.GetFirstApproxDB());
+}
+
+TEST_F(pathfinder_tests, parallelFrontier)
+{
+	auto serial   = MakeCircularFinder();
+	auto parallel = MakeCircularFinder();
+	parallel.SetThreads(4);
+	serial  .FirstApprox();
+	parallel.FirstApprox();
+	ExpectEqualDBs(serial.GetFirstApproxDB(), parallel.GetFirstApproxDB());
+}
+
+TEST_F(pathfinder_tests, legCache)
+{
+	// launch dates inside of one time fraction share their legs
+	auto offsets = std::vector<FReal>{ 0., 600., 1200., 1800., 2400., 3000. };
+	auto solve = [&offsets](Int32 threads, size_t legCacheLimit)
+	{
+		auto finder = MakeCircularFinder([legCacheLimit](Pathfinder::Mission& mission)
+		{
+			MakeDiscrete(mission);
+			mission.faxConfig.legCacheLimit = legCacheLimit;
+		});
+		finder.SetThreads(threads);
+		finder.FirstApprox(offsets, threads);
+		return finder;
+	};
+
+	auto serial = solve(1, 64 << 20);
+	auto stats  = serial.GetLegCacheStats();
+	EXPECT_EQ(stats.misses , 1);
+	EXPECT_EQ(stats.hits   , offsets.size() - 1);
+	EXPECT_EQ(stats.entries, 1);
+	EXPECT_GT(stats.bytes  , 0);
+	for (auto& [t0, flights] : serial.GetFirstApproxDB())
+	{
+		ASSERT_GE(flights.size(), 1);
+		for (auto& flight : flights)
+		{
+			EXPECT_EQ(flight.startTime, t0);
+		}
+	}
+
+	// the legs don't depend on the order they are requested in
+	auto parallel = solve(4, 64 << 20);
+	ExpectEqualDBs(serial.GetFirstApproxDB(), parallel.GetFirstApproxDB());
+
+	// the legs are still solved but not kept over the memory cap
+	auto capped = solve(1, 1);
+	EXPECT_EQ(capped.GetLegCacheStats().entries, 0);
+	EXPECT_EQ(capped.GetLegCacheStats().refused, offsets.size());
+	ExpectEqualDBs(serial.GetFirstApproxDB(), capped.GetFirstApproxDB());
+
+	// the departure states of continuous ephemerides change inside of a time fraction
+	EXPECT_THROW(MakeCircularFinder([](Pathfinder::Mission& mission)
+	{
+		mission.faxConfig.legCacheLimit = 64 << 20;
+	}), std::runtime_error);
+}
+
+TEST_F(pathfinder_tests, branchAndBound)
+{
+	auto offsets = std::vector<FReal>{ 0., 3600. * 24 * 20, 3600. * 24 * 40, 3600. * 24 * 60 };
+	auto solve = [&offsets](Int32 threads, size_t pruneTopK)
+	{
+		auto finder = MakeFlybyFinder([pruneTopK](Pathfinder::Mission& mission)
+		{
+			mission.faxConfig.pruneTopK = pruneTopK;
+		});
+		finder.SetThreads(threads);
+		finder.FirstApprox(offsets, threads);
+
+		auto values = std::vector<FReal>();
+		for (auto& [_, flights] : finder.GetFirstApproxDB())
+		for (auto& flight : flights)
+		{
+			values.push_back(flight.Impulse + flight.Mismatch);
+		}
+		std::sort(values.begin(), values.end());
+		return std::make_tuple(values, finder.GetPrunedCount());
+	};
+
+	constexpr auto K = size_t(5);
+	auto [all, none] = solve(1, 0);
+	ASSERT_GT(all.size(), K);
+	EXPECT_EQ(none, 0);
+
+	// the K best flights survive whatever is pruned
+	for (auto threads : { 1, 4 })
+	{
+		auto [best, pruned] = solve(threads, K);
+		ASSERT_GE(best.size(), K);
+		EXPECT_GT(pruned, 0);
+		EXPECT_LT(best.size(), all.size());
+		for (size_t i = 0; i < K; ++i)
+		{
+			EXPECT_EQ(best[i], all[i]);
+		}
+	}
+
+	// bounds are required to prune
+	auto finder = MakeFlybyFinder([](Pathfinder::Mission& mission)
+	{
+		mission.faxConfig.pruneTopK = K;
+	});
+	finder.SetPartialBound(nullptr);
+	EXPECT_THROW(finder.FirstApprox(), std::runtime_error);
+}
+
+TEST_F(pathfinder_tests, onlineFilter)
+{
+	using namespace Pathfinder;
+
+	auto offsets = std::vector<FReal>();
+	for (auto i = 0; i < 8; ++i)
+	{
+		offsets.push_back(3600. * 24 * 10 * i);
+	}
+	auto solve = [&offsets](Int32 threads, const PathFinder::OnlineFilter& filter)
+	{
+		auto finder = MakeCircularFinder();
+		finder.SetThreads(threads);
+		finder.SetFunctionality(GetImpulse);
+		finder.SetOnlineFilter(filter);
+		finder.FirstApprox(offsets, threads);
+		return finder;
+	};
+	auto values = [](const PathFinder& finder)
+	{
+		auto values = std::vector<FReal>();
+		for (auto& [_, flights] : finder.GetFirstApproxDB())
+		for (auto& flight : flights)
+		{
+			values.push_back(flight.Impulse);
+		}
+		std::sort(values.begin(), values.end());
+		return values;
+	};
+
+	auto offline = solve(1, {});
+	auto all = values(offline);
+	auto [min, max] = offline.GetFunctionalityBounds();
+
+	// the K best flights are kept exactly
+	constexpr auto K = size_t(10);
+	ASSERT_GT(all.size(), K);
+	for (auto threads : { 1, 4 })
+	{
+		auto online = solve(threads, { K, NAN });
+		EXPECT_EQ(values(online), std::vector<FReal>(all.begin(), all.begin() + K));
+		EXPECT_EQ(online.GetFunctionalityBounds(), std::make_tuple(min, max));
+	}
+
+	// the offline top K leaves the same flights; ties are cut by the DB's order and NaNs are dropped
+	auto best = solve(1, {});
+	EXPECT_EQ(best.KeepBestResults(K), K);
+	EXPECT_EQ(values(best), std::vector<FReal>(all.begin(), all.begin() + K));
+
+	auto below = size_t(std::lower_bound(all.begin(), all.end(), all[K]) - all.begin());
+	auto tied  = solve(1, {});
+	tied.SetFunctionality([limit = all[K]](const PathFinder::FlightChain& flight)
+	{
+		return flight.Impulse < limit ? 0. : NAN;
+	});
+	EXPECT_EQ(tied.KeepBestResults(all.size()), below);
+	EXPECT_EQ(tied.KeepBestResults(K / 2), K / 2);
+	EXPECT_EQ(tied.FAXDBSize(), K / 2);
+
+	// the online keep factor leaves a part of the offline one
+	offline.FilterResults(min + (max - min) * 0.2);
+	auto kept = values(offline);
+	auto online = values(solve(1, { 0, 0.2 }));
+	ASSERT_GT(online.size(), 0);
+	EXPECT_LE(online.size(), kept.size());
+	EXPECT_TRUE(std::includes(kept.begin(), kept.end(), online.begin(), online.end()));
+	EXPECT_EQ(online.front(), kept.front());
+}
+
+TEST_F(pathfinder_tests, parallelSecondApprox)
+{
+	using namespace Pathfinder;
+
+	auto solve = [](Int32 threads)
+	{
+		auto finder = MakeSeededFinder();
+		finder.SetThreads(threads);
+		return finder.SecondApprox();
+	};
+
+	auto serial   = solve(1);
+	auto parallel = solve(4);
+	ASSERT_EQ(serial.size(), parallel.size());
+	for (auto pos1 = serial.begin(), pos2 = parallel.begin(); pos1 != serial.end(); ++pos1, ++pos2)
+	{
+		EXPECT_EQ(pos1->first, pos2->first);
+		EXPECT_EQ(pos1->second.functionality, pos2->second.functionality);
+	}
+}
+
+TEST_F(pathfinder_tests, saxMinimisers)
+{
+	using namespace Pathfinder;
+
+	// returns the DB and the values of the seeds' optimisations (NAN - failed)
+	// \note: the values are in the seeds' order with one worker
+	// \note: secondApprox.* benchmarks run the same minimisations
+	auto solve = [](ESAXMinimiser minimiser, Int32 threads, Int32 iterations)
+	{
+		auto finder = MakeSeededFinder([minimiser, iterations](Mission& mission)
+		{
+			mission.saxConfig.minimiser = minimiser;
+			mission.saxConfig.maxMinimisationIters = iterations;
+		});
+		finder.SetThreads(threads);
+		auto values = std::vector<FReal>();
+		auto db = finder.SecondApprox([&values](const PathFinder::FlightChain&, const std::optional<PathFinder::SecondApproxData>& result)
+		{
+			values.push_back(result ? result->functionality : NAN);
+		});
+		return std::make_tuple(db, values);
+	};
+
+	// the minimisers start where no iteration moves them
+	auto start = std::get<1>(solve(ESAXMinimiser::eSimplex, 1, 0));
+	ASSERT_GT(start.size(), 0);
+
+	for (auto [minimiser, name] : {
+		  std::make_tuple(ESAXMinimiser::eSimplex  , "simplex"  )
+		, std::make_tuple(ESAXMinimiser::eBFGS2    , "bfgs2"    )
+		, std::make_tuple(ESAXMinimiser::eConjugate, "conjugate")
+	}) {
+		auto [serial, values] = solve(minimiser, 1, 10);
+		ASSERT_GT(serial.size(), 0) << name;
+
+		// a minimiser doesn't leave a flight worse than its seed
+		ASSERT_EQ(values.size(), start.size()) << name;
+		auto compared = 0;
+		for (size_t i = 0; i < start.size(); ++i)
+		{
+			if (!isnan(start[i]))
+			{
+				EXPECT_LE(values[i], start[i]) << name << ", seed " << i;
+				++compared;
+			}
+		}
+		EXPECT_GT(compared, 0) << name;
+
+		auto evaluations = UInt64(0);
+		for (auto& [_, data] : serial)
+		{
+			evaluations += data.evaluations;
+		}
+		EXPECT_GT(evaluations, 0) << name;
+
+		if (minimiser == ESAXMinimiser::eSimplex)
+		{
+			continue;
+		}
+
+		// the differences don't depend on the workers
+		auto parallel = std::get<0>(solve(minimiser, 4, 10));
+		ASSERT_EQ(serial.size(), parallel.size());
+		for (auto pos1 = serial.begin(), pos2 = parallel.begin(); pos1 != serial.end(); ++pos1, ++pos2)
+		{
+			EXPECT_EQ(pos1->second.functionality, pos2->second.functionality);
+			EXPECT_EQ(pos1->second.evaluations, pos2->second.evaluations);
+		}
+	}
+}
+
+TEST_F(pathfinder_tests, globalSAX)
+{
+	using namespace Pathfinder;
+
+	constexpr auto budget = UInt64(400);
+	auto solve = [](ESAXGlobal global, Int32 threads)
+	{
+		auto finder = MakeSeededFinder([global](Mission& mission)
+		{
+			mission.saxConfig.global = global;
+			mission.saxConfig.evaluationBudget = budget;
+			mission.saxConfig.globalPopulation = 8;
+			mission.saxConfig.randomSeed = 42;
+		});
+		finder.SetThreads(threads);
+		return finder.SecondApprox();
+	};
+
+	auto local = solve(ESAXGlobal::eNone, 1);
+	ASSERT_GT(local.size(), 0);
+
+	for (auto global : { ESAXGlobal::eDifferentialEvolution, ESAXGlobal::eMultiStart })
+	{
+		auto serial = solve(global, 1);
+		auto parallel = solve(global, 4);
+		ASSERT_EQ(serial.size(), local.size());
+
+		for (auto pos1 = serial.begin(), pos2 = parallel.begin(), pos0 = local.begin(); pos1 != serial.end(); ++pos0, ++pos1, ++pos2)
+		{
+			// the points are drawn with the seeded generator, so the workers don't change the search
+			EXPECT_EQ(pos1->second.functionality, pos2->second.functionality);
+			EXPECT_EQ(pos1->second.evaluations, pos2->second.evaluations);
+
+			// \note: the final flight of the evolution is computed over the budget
+			EXPECT_LE(pos1->second.evaluations, budget + 1);
+
+			// the first restart is the local minimisation from the seed
+			if (global == ESAXGlobal::eMultiStart)
+			{
+				EXPECT_LE(pos1->second.functionality, pos0->second.functionality);
+			}
+		}
+	}
+}
+
+TEST_F(pathfinder_tests, clusterResults)
+{
+	using namespace Pathfinder;
+
+	auto finder = MakeCircularFinder();
+	finder.SetFunctionality(GetImpulse);
+	for (auto t : { 0., 3600. * 24, 3600. * 24 * 2 })
+	{
+		finder.FirstApprox(t);
+	}
+	auto count = finder.FAXDBSize();
+	auto [min, max] = finder.GetFunctionalityBounds();
+
+	// neighbouring dates and toss angles merge
+	auto left = finder.ClusterResults({ 3600. * 24 * 3, 0.2 });
+	EXPECT_EQ(left, finder.FAXDBSize());
+	EXPECT_LT(left, count);
+
+	auto total = size_t(0);
+	for (auto& [_, flights] : finder.GetFirstApproxDB())
+	for (auto& flight : flights)
+	{
+		total += flight.clusterSize;
+	}
+	EXPECT_EQ(total, count);
+
+	// the best flight is a leader
+	EXPECT_EQ(std::get<0>(finder.GetFunctionalityBounds()), min);
+
+	// SAX flights inherit the counts
+	finder.FilterResults(min + (max - min) * 0.05);
+	for (auto& [_, data] : finder.SecondApprox())
+	{
+		EXPECT_GE(data.chain.clusterSize, 1);
+	}
+
+	// leaders aren't near each other, so clustering again changes nothing
+	auto size = finder.FAXDBSize();
+	EXPECT_EQ(finder.ClusterResults({ 3600. * 24 * 3, 0.2 }), size);
+}
+
+TEST_F(pathfinder_tests, stageMetrics)
+{
+	using namespace Pathfinder;
+
+	// \note: the registry is shared by the tests, so increments are checked
+	auto before = Metrics::Registry::Get().Collect();
+
+	auto finder = MakeSeededFinder([](Mission& mission)
+	{
+		mission.faxConfig.threads = 4;
+		mission.saxConfig.threads = 4;
+	}, { 0., 3600. * 24 });
+	auto seeds = finder.FAXDBSize();
+	finder.SecondApprox();
+
+	auto after = Metrics::Registry::Get().Collect();
+	auto counter = [&](const std::string& name)
+	{
+		return after.counters[name] - before.counters[name];
+	};
+	auto count = [&](std::map<std::string, Metrics::Summary> Metrics::Report::* list, const std::string& name)
+	{
+		return (after.*list)[name].count - (before.*list)[name].count;
+	};
+
+	EXPECT_GT(count(&Metrics::Report::timers, "Link.FindLinks.time"), 0);
+	EXPECT_GT(count(&Metrics::Report::histograms, "FindAsRoot.evaluations"), 0);
+	EXPECT_GT(counter("INode.Check.calls"), counter("INode.Check.rejected"));
+	EXPECT_EQ(count(&Metrics::Report::timers, "SAX.time"), seeds);
+	EXPECT_EQ(count(&Metrics::Report::histograms, "SAX.evaluations"), seeds);
+	EXPECT_EQ(counter("SAX.count_of_failed_paths"), seeds - finder.SAXDBSize());
+
+	// a missed root is one the polisher didn't get within the tolerance
+	EXPECT_LE(count(&Metrics::Report::histograms, "FindAsRoot.missed_root"), counter("FindAsRoot.count_of_missed_roots"));
+	if (counter("FindAsRoot.count_of_missed_roots"))
+	{
+		EXPECT_GT(after.histograms["FindAsRoot.missed_root"].min, 0);
+	}
+}
+
+TEST_F(pathfinder_tests, resume)
+{
+	using namespace Pathfinder;
+
+	auto offsets = std::vector<FReal>{ 0., 3600. * 24, 3600. * 48 };
+	auto make = []()
+	{
+		auto finder = MakeCircularFinder();
+		finder.SetThreads(2);
+		finder.SetFunctionality(GetImpulse);
+		return finder;
+	};
+
+	// a full run logs each date and each optimised flight
+	auto faxLog = std::vector<std::tuple<FReal, std::vector<PathFinder::FlightChain>>>();
+	auto saxLog = std::vector<std::tuple<PathFinder::FlightChain, std::optional<PathFinder::SecondApproxData>>>();
+	auto full = make();
+	full.FirstApprox(offsets, 2, [&](FReal offset, const std::vector<PathFinder::FlightChain>& flights)
+	{
+		faxLog.emplace_back(offset, flights);
+	});
+	auto [min, max] = full.GetFunctionalityBounds();
+	full.FilterResults(min + (max - min) * 0.05);
+	auto& reference = full.SecondApprox([&](const PathFinder::FlightChain& seed, const std::optional<PathFinder::SecondApproxData>& result)
+	{
+		saxLog.emplace_back(seed, result);
+	});
+	ASSERT_EQ(faxLog.size(), offsets.size());
+	ASSERT_EQ(saxLog.size(), full.FAXDBSize());
+
+	// a run killed after the first date computes the other dates only
+	auto extended = make();
+	extended.RestoreFirstApprox(std::get<0>(faxLog[0]), std::vector(std::get<1>(faxLog[0])));
+	auto computed = std::vector<FReal>();
+	extended.FirstApprox(std::vector<FReal>(offsets.begin() + 1, offsets.end()), 2, [&](FReal offset, const std::vector<PathFinder::FlightChain>&)
+	{
+		computed.push_back(offset);
+	});
+	EXPECT_EQ(computed, std::vector<FReal>(offsets.begin() + 1, offsets.end()));
+	EXPECT_EQ(extended.GetFunctionalityBounds(), std::make_tuple(min, max));
+
+	// a run killed during SAX optimises the left flights only
+	extended.FilterResults(min + (max - min) * 0.05);
+	ASSERT_EQ(extended.FAXDBSize(), full.FAXDBSize());
+	auto restored = saxLog.size() / 2;
+	for (size_t i = 0; i < restored; ++i)
+	{
+		auto& [seed, result] = saxLog[i];
+		extended.RestoreSecondApprox(seed, std::optional(result));
+	}
+	auto optimised = size_t(0);
+	auto& resumed = extended.SecondApprox([&](const PathFinder::FlightChain&, const std::optional<PathFinder::SecondApproxData>&)
+	{
+		++optimised;
+	});
+	EXPECT_EQ(optimised, saxLog.size() - restored);
+
+	ASSERT_EQ(resumed.size(), reference.size());
+	for (auto pos1 = reference.begin(), pos2 = resumed.begin(); pos1 != reference.end(); ++pos1, ++pos2)
+	{
+		EXPECT_EQ(pos1->first, pos2->first);
+		EXPECT_EQ(pos1->second.functionality, pos2->second.functionality);
+	}
+
+	// results are matched by seeds, so a DB filtered another way optimises only the seeds with no result
+	auto looser = make();
+	for (auto& [offset, flights] : faxLog)
+	{
+		looser.RestoreFirstApprox(offset, std::vector(flights));
+	}
+	looser.FilterResults(min + (max - min) * 0.1);
+	ASSERT_GT(looser.FAXDBSize(), saxLog.size());
+	for (auto& [seed, result] : saxLog)
+	{
+		looser.RestoreSecondApprox(seed, std::optional(result));
+	}
+	optimised = 0;
+	looser.SecondApprox([&](const PathFinder::FlightChain&, const std::optional<PathFinder::SecondApproxData>&)
+	{
+		++optimised;
+	});
+	EXPECT_EQ(optimised, looser.FAXDBSize() - saxLog.size());
+}
+
 TEST_F(pathfinder_tests, realPlanets)
 {
 	using namespace Pathfinder;
@@ -110,7 +753,7 @@ TEST_F(pathfinder_tests, realPlanets)
 	for (auto& path : paths)
 	{
 		ASSERT_EQ(path.chain.size(), 1);
-		links[path.Impulse] = path.chain.rbegin()->link;
+		links[path.Impulse] = path.GetLink(path.chain.size() - 1);
 	}
 	ASSERT_GE(paths.size(), 1);
 
@@ -1,5 +1,8 @@
 #include "gtest/gtest.h"
 #include "planetScript.hpp"
+#include "ephemerisCache.hpp"
+#include <filesystem>
+#include <fstream>
 
 
 
@@ -114,6 +117,52 @@ TEST_F(planetScript_tests, DiscreteMode)
 	}
 }
 
+TEST_F(planetScript_tests, EphemerisCache)
+{
+	using namespace Pathfinder::PlanetScript;
+	const auto date = std::string("2019-01-01, 12:00:00 TDB");
+	const auto path = (std::filesystem::temp_directory_path() / "planetScript_tests.ephem").string();
+
+	auto step  = 3600. * 6;
+	auto chunk = 3600. * 24 * 10;
+	auto tEnd  = 3600. * 24 * 30;
+	ASSERT_NO_THROW(EphemerisCache::Build(path, date, { EPlanet::eSun, EPlanet::eEarth }, step, chunk, 0, tEnd));
+
+	auto epd = PlanetScript(EPlanet::eEarth, date);
+	epd.MakeDiscret(step, chunk);
+	epd.Preload(0, tEnd);
+
+	auto cache = EphemerisCache::Open(path);
+	auto epc = cache->MakeScript(EPlanet::eEarth, date);
+	EXPECT_EQ(cache->GetGM(EPlanet::eSun), PlanetScript(EPlanet::eSun, date).GetGM(0));
+	EXPECT_EQ(epc->GetGM(0), epd.GetGM(0));
+	EXPECT_EQ(epc->GetT (0), epd.GetT (0));
+	EXPECT_FALSE(cache->Contains(EPlanet::eMars));
+	EXPECT_THROW(cache->MakeScript(EPlanet::eEarth, "2020-01-01, 12:00:00 TDB"), std::runtime_error);
+
+	for (auto t = 0.; t < tEnd; t += step * 0.7)
+	{
+		auto [rc, vc] = epc->GetMovement(t);
+		auto [rd, vd] = epd.GetMovement(t);
+		ASSERT_EQ(rc, rd) << t;
+		ASSERT_EQ(vc, vd) << t;
+	}
+
+	// times out of the cache aren't answered by SPICE
+	auto [rangeBegin, rangeEnd] = cache->GetRange(EPlanet::eEarth);
+	EXPECT_LE(rangeBegin, 0);
+	EXPECT_GT(rangeEnd, tEnd);
+	EXPECT_THROW(epc->GetMovement(rangeEnd + step), std::runtime_error);
+	EXPECT_THROW(epc->GetLocation(rangeBegin - step), std::runtime_error);
+
+	// a foreign file is rejected
+	cache.reset();
+	epc.reset();
+	std::ofstream(path, std::ios::trunc) << "not a cache, but long enough to have a header of the cache file format";
+	EXPECT_THROW(EphemerisCache::Open(path), std::runtime_error);
+	std::filesystem::remove(path);
+}
+
 #if 0
 #include <fstream>
 TEST_F(planetScript_tests, ExportOrbit)
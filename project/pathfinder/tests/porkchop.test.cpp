@@ -0,0 +1,99 @@
+#include "gtest/gtest.h"
+#include "porkchop.hpp"
+#include "solvers/porkchopScan.hpp"
+#include "planetScriptSimple.hpp"
+
+
+
+struct porkchop_tests : public testing::Test
+{
+	// Earth -> Mars on circular orbits with the Hohmann phase distance at t = 0
+	static Pathfinder::Porkchop::PorkchopConfig MakeConfig(Int32 threads = 1)
+	{
+		using namespace Pathfinder;
+		auto conf = Porkchop::PorkchopConfig();
+		conf.A  = std::make_shared<PlanetScript::PlanetScriptSimple>(3.986E+14, 149.6E+9, 31.6E+6, .5 + 0.);
+		conf.B  = std::make_shared<PlanetScript::PlanetScriptSimple>(4.282E+13, 227.9E+9, 59.4E+6, .5 + 0.776);
+		conf.GM = 1.327E+20;
+		conf.t0 = 0;
+		conf.t1 = 3600 * 24 * 40;
+		conf.dt = 3600 * 24 * 10;
+		conf.tof0 = 3600 * 24 * 200;
+		conf.tof1 = 3600 * 24 * 320;
+		conf.dtof = 3600 * 24 * 10;
+		conf.threads = threads;
+		return conf;
+	}
+};
+
+
+TEST_F(porkchop_tests, hohmann)
+{
+	auto grid = Pathfinder::Porkchop::Porkchop(MakeConfig());
+	ASSERT_EQ(grid.GetDepartures().size(), 5);
+	ASSERT_EQ(grid.GetFlightTimes().size(), 13);
+
+	auto cells = std::vector<Pathfinder::Porkchop::Cell>();
+	grid.ComputeRow(0, cells);
+	ASSERT_EQ(cells.size(), grid.GetFlightTimes().size());
+
+	// the cheapest transfer of the first date is the Hohmann one (~258 days, ~2.9 + ~2.6 km/s)
+	auto best = std::min_element(cells.begin(), cells.end(), [](auto& a, auto& b)
+	{
+		return isnan(b.w0) || (!isnan(a.w0) && a.w0 + a.w1 < b.w0 + b.w1);
+	});
+	ASSERT_FALSE(isnan(best->w0));
+	EXPECT_NEAR(grid.GetFlightTimes()[best - cells.begin()], 3600 * 24 * 260, 3600 * 24 * 20);
+	EXPECT_NEAR(best->w0, 2.95e+3, 0.3e+3);
+	EXPECT_NEAR(best->w1, 2.65e+3, 0.3e+3);
+}
+
+TEST_F(porkchop_tests, parallelRows)
+{
+	auto serial   = Pathfinder::Porkchop::Porkchop(MakeConfig(1));
+	auto parallel = Pathfinder::Porkchop::Porkchop(MakeConfig(4));
+
+	auto rows = std::vector<size_t>();
+	parallel.Compute([&](size_t row, const auto& cells)
+	{
+		rows.push_back(row);
+
+		auto expected = std::vector<Pathfinder::Porkchop::Cell>();
+		serial.ComputeRow(row, expected);
+		ASSERT_EQ(cells.size(), expected.size());
+		for (size_t i = 0; i < cells.size(); ++i)
+		{
+			EXPECT_EQ(isnan(cells[i].w0), isnan(expected[i].w0));
+			if (!isnan(cells[i].w0))
+			{
+				EXPECT_EQ(cells[i].w0, expected[i].w0);
+				EXPECT_EQ(cells[i].w1, expected[i].w1);
+			}
+		}
+	});
+	ASSERT_EQ(rows, std::vector<size_t>({ 0, 1, 2, 3, 4 }));
+}
+
+TEST_F(porkchop_tests, wrappedBracket)
+{
+	using namespace Pathfinder;
+
+	// a mismatch with roots at pi/2 and 3pi/2: the second one is between the last angle and the first one
+	auto brackets = std::vector<std::tuple<FReal, FReal>>();
+	Porkchop::Utiles::ScanBrackets({ 0, Math::Pi }, [](FReal f0) { return Math::Cos(f0); }, [&](FReal fa, FReal va, FReal fb)
+	{
+		EXPECT_EQ(va, Math::Cos(fa));
+		brackets.emplace_back(fa, fb);
+	});
+	ASSERT_EQ(brackets.size(), 2);
+	EXPECT_EQ(brackets[0], std::make_tuple(FReal(0), Math::Pi));
+	EXPECT_EQ(brackets[1], std::make_tuple(Math::Pi, 2 * Math::Pi));
+
+	// no link at an angle brackets nothing
+	brackets.clear();
+	Porkchop::Utiles::ScanBrackets({ 0, Math::Pi }, [](FReal f0) { return f0 > 0 ? Math::Cos(f0) : NAN; }, [&](FReal fa, FReal va, FReal fb)
+	{
+		brackets.emplace_back(fa, fb);
+	});
+	EXPECT_TRUE(brackets.empty());
+}
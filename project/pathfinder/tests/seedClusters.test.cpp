@@ -0,0 +1,68 @@
+#include "gtest/gtest.h"
+#include "solvers/seedClusters.hpp"
+
+
+struct seedClusters_tests : public testing::Test
+{
+	using FlightChain = Pathfinder::PathFinder::FlightChain;
+	using FlightRecord = Pathfinder::PathFinder::FlightRecord;
+
+	static FlightChain MakeFlight(FReal startTime, std::vector<std::tuple<FReal, FReal>> legs)
+	{
+		auto flight = FlightRecord();
+		flight.startTime = startTime;
+		for (auto [f0, dt] : legs)
+		{
+			auto& info = flight.chain.emplace_back();
+			info.link.f0 = f0;
+			info.link.dt = dt;
+		}
+		return flight.ToChain();
+	}
+
+	static auto Cluster(const std::vector<FlightChain>& flights, const std::vector<FReal>& values)
+	{
+		auto pointers = std::vector<const FlightChain*>();
+		for (auto& flight : flights)
+		{
+			pointers.push_back(&flight);
+		}
+		return Pathfinder::Solvers::ClusterFlights(pointers, values, 3600. * 24, 0.01);
+	}
+};
+
+TEST_F(seedClusters_tests, leaders)
+{
+	constexpr auto day = 3600. * 24;
+	auto flights = std::vector{
+		MakeFlight(0.0 * day, { { 1.000, 100 * day } }),
+		MakeFlight(0.5 * day, { { 1.005, 100 * day } }), // near to the first one
+		MakeFlight(0.5 * day, { { 1.050, 100 * day } }), // the angle is far
+		MakeFlight(0.5 * day, { { 1.000, 102 * day } }), // the flight time is far
+		MakeFlight(3.0 * day, { { 1.000, 100 * day } }), // the date is far
+		MakeFlight(0.0 * day, { { 1.000, 100 * day }, { 1, day } }), // the legs differ
+		MakeFlight(0.0 * day, { { 2*Math::Pi + 0.999, 100 * day } }), // near through the full turn
+	};
+
+	// the best flight of a cluster leads it
+	auto leaders = Cluster(flights, { 2, 1, 5, 5, 5, 5, 3 });
+	EXPECT_EQ(leaders, std::vector<size_t>({ 1, 1, 2, 3, 4, 5, 1 }));
+
+	// the flights are visited from the best one, and NAN is the worst value
+	leaders = Cluster(flights, { NAN, 1, 5, 5, 5, 5, 0 });
+	EXPECT_EQ(leaders, std::vector<size_t>({ 6, 6, 2, 3, 4, 5, 6 }));
+}
+
+TEST_F(seedClusters_tests, chains)
+{
+	// a flight joins the best near leader, not the first one
+	auto flights = std::vector{
+		MakeFlight(0, { { 1.000, 0 } }),
+		MakeFlight(0, { { 1.016, 0 } }),
+		MakeFlight(0, { { 1.008, 0 } }),
+	};
+	EXPECT_EQ(Cluster(flights, { 2, 1, 3 }), std::vector<size_t>({ 0, 1, 1 }));
+	EXPECT_EQ(Cluster(flights, { 1, 2, 3 }), std::vector<size_t>({ 0, 1, 0 }));
+
+	EXPECT_ANY_THROW(Cluster(flights, { 1 }));
+}